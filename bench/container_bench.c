@@ -0,0 +1,655 @@
+/************************************************ 
+EXERCISE      : Container microbenchmark
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : container_bench.c
+*************************************************/
+
+#define _GNU_SOURCE /* syscall */
+#include <stdio.h>            /* printf */
+#include <stdlib.h>           /* malloc, rand, strtoul */
+#include <string.h>           /* memset */
+#include <unistd.h>           /* syscall, read, close */
+#include <sys/ioctl.h>        /* ioctl */
+#include <sys/syscall.h>      /* __NR_perf_event_open */
+#include <linux/perf_event.h> /* struct perf_event_attr */
+
+#include "dlist.h"
+#include "sorted_list.h"
+#include "priority_queue.h"
+#include "mono_time.h"
+
+#define MIN_SIZE     (100)
+#define MAX_SIZE     (10000)
+#define SEARCH_OPS   (1000)   /* operations that walk the container run at most this many times */
+#define SPLICE_RUN   (16)     /* nodes moved by one DListSplice */
+#define NO_COUNTER   (-1)
+
+/*
+*  prints one CSV line per operation, key pattern and size: ns,
+*  allocations and last level cache misses per operation. the misses are
+*  counted with perf_event_open and printed as - where it is not allowed.
+*  malloc, calloc and realloc are wrapped by the linker to count the
+*  allocations, see the container_bench make target.
+*
+*  usage: container_bench.out [max_size]
+*/
+
+typedef enum key_pattern
+{
+	KEYS_RANDOM,
+	KEYS_MONOTONIC
+} key_pattern_t;
+
+typedef struct measure
+{
+	uint64_t ns;
+	size_t allocs;
+	uint64_t misses;
+} measure_t;
+
+typedef struct bench_case
+{
+	const char *container;
+	const char *op;
+	size_t (*run)(int *keys, size_t n, measure_t *measure);  /* returns the number of operations */
+} bench_case_t;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t count, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+static size_t DListInsertRun(int *keys, size_t n, measure_t *measure);
+static size_t DListFindRun(int *keys, size_t n, measure_t *measure);
+static size_t DListSpliceRun(int *keys, size_t n, measure_t *measure);
+static size_t DListSortedInsertRun(int *keys, size_t n, measure_t *measure);
+static size_t DListSortedHintRun(int *keys, size_t n, measure_t *measure);
+static size_t DListSortedFindRun(int *keys, size_t n, measure_t *measure);
+static size_t DListSortedMergeRun(int *keys, size_t n, measure_t *measure);
+static size_t SkipInsertRun(int *keys, size_t n, measure_t *measure);
+static size_t SkipHintRun(int *keys, size_t n, measure_t *measure);
+static size_t SkipFindRun(int *keys, size_t n, measure_t *measure);
+static size_t SkipMergeRun(int *keys, size_t n, measure_t *measure);
+static size_t VectorInsertRun(int *keys, size_t n, measure_t *measure);
+static size_t VectorHintRun(int *keys, size_t n, measure_t *measure);
+static size_t VectorFindRun(int *keys, size_t n, measure_t *measure);
+static size_t VectorMergeRun(int *keys, size_t n, measure_t *measure);
+static size_t ListEnqueueRun(int *keys, size_t n, measure_t *measure);
+static size_t ListDequeueRun(int *keys, size_t n, measure_t *measure);
+static size_t ListEraseRun(int *keys, size_t n, measure_t *measure);
+static size_t HeapEnqueueRun(int *keys, size_t n, measure_t *measure);
+static size_t HeapDequeueRun(int *keys, size_t n, measure_t *measure);
+static size_t HeapEraseRun(int *keys, size_t n, measure_t *measure);
+
+static size_t SortedInsert(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t SortedHint(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t SortedFind(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t SortedMerge(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t Enqueue(pq_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t Dequeue(pq_backend_t backend, int *keys, size_t n, measure_t *measure);
+static size_t Erase(pq_backend_t backend, int *keys, size_t n, measure_t *measure);
+static pq_t *FilledQueue(pq_backend_t backend, int *keys, size_t n);
+static dlist_t *FilledList(int *keys, size_t n);
+static void MakeKeys(int *keys, size_t n, key_pattern_t pattern);
+static void Start(measure_t *measure);
+static void Stop(measure_t *measure);
+static int OpenCacheMisses(void);
+static int CmpInt(const void *data1, const void *data2);
+static int IsSameKey(const void *data, const void *param);
+static int IsSameData(const void *data, const void *param);
+
+static const bench_case_t cases[] =
+{
+	{"dlist", "insert", &DListInsertRun},
+	{"dlist", "find", &DListFindRun},
+	{"dlist", "splice", &DListSpliceRun},
+	{"sorted_list", "insert", &DListSortedInsertRun},
+	{"sorted_list", "insert_hint", &DListSortedHintRun},
+	{"sorted_list", "find", &DListSortedFindRun},
+	{"sorted_list", "merge", &DListSortedMergeRun},
+	{"sorted_list_skip", "insert", &SkipInsertRun},
+	{"sorted_list_skip", "insert_hint", &SkipHintRun},
+	{"sorted_list_skip", "find", &SkipFindRun},
+	{"sorted_list_skip", "merge", &SkipMergeRun},
+	{"sorted_list_vector", "insert", &VectorInsertRun},
+	{"sorted_list_vector", "insert_hint", &VectorHintRun},
+	{"sorted_list_vector", "find", &VectorFindRun},
+	{"sorted_list_vector", "merge", &VectorMergeRun},
+	{"pq_sorted_list", "enqueue", &ListEnqueueRun},
+	{"pq_sorted_list", "dequeue", &ListDequeueRun},
+	{"pq_sorted_list", "erase", &ListEraseRun},
+	{"pq_heap", "enqueue", &HeapEnqueueRun},
+	{"pq_heap", "dequeue", &HeapDequeueRun},
+	{"pq_heap", "erase", &HeapEraseRun}
+};
+
+static const char *pattern_names[] = {"random", "monotonic"};
+
+static size_t n_allocs = 0;
+static int misses_fd = NO_COUNTER;
+
+int main(int argc, char *argv[])
+{
+	size_t max_size = MAX_SIZE;
+	measure_t measure = {0};
+	int *keys = NULL;
+	size_t ops = 0;
+	size_t n = 0;
+	size_t i = 0;
+	int pattern = 0;
+	
+	if (1 < argc)
+	{
+		max_size = (size_t)strtoul(argv[1], NULL, 10);
+	}
+	
+	keys = (int *)malloc(max_size * sizeof(int));
+	if (NULL == keys)
+	{
+		fprintf(stderr, "Memory allocation failed.\n");
+		return EXIT_FAILURE;
+	}
+	
+	misses_fd = OpenCacheMisses();
+	
+	printf("container,op,keys,size,ns_per_op,allocs_per_op,cache_misses_per_op\n");
+	
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+	{
+		for (pattern = KEYS_RANDOM; pattern <= KEYS_MONOTONIC; ++pattern)
+		{
+			for (n = MIN_SIZE; n <= max_size; n *= 10)
+			{
+				MakeKeys(keys, n, (key_pattern_t)pattern);
+				ops = cases[i].run(keys, n, &measure);
+	
+				printf("%s,%s,%s,%lu,%.1f,%.2f,", cases[i].container, cases[i].op,
+				       pattern_names[pattern], (unsigned long)n, (double)measure.ns / ops,
+				       (double)measure.allocs / ops);
+				if (NO_COUNTER == misses_fd)
+				{
+					printf("-\n");
+				}
+				else
+				{
+					printf("%.2f\n", (double)measure.misses / ops);
+				}
+			}
+		}
+	}
+	
+	if (NO_COUNTER != misses_fd)
+	{
+		close(misses_fd);
+	}
+	free(keys);
+	
+	return EXIT_SUCCESS;
+}
+
+/*-----------------Allocation counters-----------------*/
+void *__wrap_malloc(size_t size)
+{
+	++n_allocs;
+	
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+	++n_allocs;
+	
+	return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	++n_allocs;
+	
+	return __real_realloc(ptr, size);
+}
+
+/*-----------------DList-----------------*/
+
+/* This function measures appending n datas */
+static size_t DListInsertRun(int *keys, size_t n, measure_t *measure)
+{
+	dlist_t *list = DListCreate();
+	size_t i = 0;
+	
+	Start(measure);
+	for (i = 0; i < n; ++i)
+	{
+		DListInsert(DListGetEnd(list), &keys[i]);
+	}
+	Stop(measure);
+	
+	DListDestroy(list);
+	
+	return n;
+}
+
+/* This function measures finding random keys of the list, from its start */
+static size_t DListFindRun(int *keys, size_t n, measure_t *measure)
+{
+	dlist_t *list = FilledList(keys, n);
+	size_t ops = (n < SEARCH_OPS) ? (n) : (SEARCH_OPS);
+	size_t targets[SEARCH_OPS];
+	volatile size_t sink = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < ops; ++i)
+	{
+		targets[i] = (size_t)rand() % n;
+	}
+	
+	Start(measure);
+	for (i = 0; i < ops; ++i)
+	{
+		sink += (size_t)DListFind(DListGetBegin(list), DListGetEnd(list), &IsSameKey, &keys[targets[i]]);
+	}
+	Stop(measure);
+	
+	DListDestroy(list);
+	
+	return ops;
+}
+
+/* This function measures moving runs of SPLICE_RUN nodes to another list, one splice each */
+static size_t DListSpliceRun(int *keys, size_t n, measure_t *measure)
+{
+	dlist_t *from = FilledList(keys, n);
+	dlist_t *to = DListCreate();
+	dlist_iter_t end = NULL;
+	size_t ops = n / SPLICE_RUN;
+	size_t i = 0;
+	size_t j = 0;
+	
+	Start(measure);
+	for (i = 0; i < ops; ++i)
+	{
+		for (end = DListGetBegin(from), j = 0; j < SPLICE_RUN; ++j)
+		{
+			end = DListNext(end);
+		}
+		DListSplice(DListGetBegin(from), end, DListGetEnd(to));
+	}
+	Stop(measure);
+	
+	DListDestroy(from);
+	DListDestroy(to);
+	
+	return ops;
+}
+
+/*-----------------Sorted List-----------------*/
+
+static size_t DListSortedInsertRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedInsert(SORTED_LIST_DLIST, keys, n, measure);
+}
+
+static size_t DListSortedHintRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedHint(SORTED_LIST_DLIST, keys, n, measure);
+}
+
+static size_t DListSortedFindRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedFind(SORTED_LIST_DLIST, keys, n, measure);
+}
+
+static size_t DListSortedMergeRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedMerge(SORTED_LIST_DLIST, keys, n, measure);
+}
+
+static size_t SkipInsertRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedInsert(SORTED_LIST_SKIP, keys, n, measure);
+}
+
+static size_t SkipHintRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedHint(SORTED_LIST_SKIP, keys, n, measure);
+}
+
+static size_t SkipFindRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedFind(SORTED_LIST_SKIP, keys, n, measure);
+}
+
+static size_t SkipMergeRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedMerge(SORTED_LIST_SKIP, keys, n, measure);
+}
+
+static size_t VectorInsertRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedInsert(SORTED_LIST_VECTOR, keys, n, measure);
+}
+
+static size_t VectorHintRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedHint(SORTED_LIST_VECTOR, keys, n, measure);
+}
+
+static size_t VectorFindRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedFind(SORTED_LIST_VECTOR, keys, n, measure);
+}
+
+static size_t VectorMergeRun(int *keys, size_t n, measure_t *measure)
+{
+	return SortedMerge(SORTED_LIST_VECTOR, keys, n, measure);
+}
+
+/* This function measures inserting n keys in their order */
+static size_t SortedInsert(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	sorted_list_t *list = SortedListCreate(&CmpInt, backend);
+	size_t i = 0;
+	
+	Start(measure);
+	for (i = 0; i < n; ++i)
+	{
+		SortedListInsert(list, &keys[i]);
+	}
+	Stop(measure);
+	
+	SortedListDestroy(list);
+	
+	return n;
+}
+
+/* This function measures inserting n keys in their order, each searched for from the last one */
+static size_t SortedHint(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	sorted_list_t *list = SortedListCreate(&CmpInt, backend);
+	sorted_list_iter_t where = SortedListEnd(list);
+	size_t i = 0;
+	
+	Start(measure);
+	for (i = 0; i < n; ++i)
+	{
+		where = SortedListInsertHint(list, where, &keys[i]);
+	}
+	Stop(measure);
+	
+	SortedListDestroy(list);
+	
+	return n;
+}
+
+/* This function measures finding random keys of the list, in all of it */
+static size_t SortedFind(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	sorted_list_t *list = SortedListCreate(&CmpInt, backend);
+	size_t ops = (n < SEARCH_OPS) ? (n) : (SEARCH_OPS);
+	size_t targets[SEARCH_OPS];
+	volatile size_t sink = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < n; ++i)
+	{
+		SortedListInsert(list, &keys[i]);
+	}
+	for (i = 0; i < ops; ++i)
+	{
+		targets[i] = (size_t)rand() % n;
+	}
+	
+	Start(measure);
+	for (i = 0; i < ops; ++i)
+	{
+		sink += (size_t)SortedListGetData(SortedListFind(list, SortedListBegin(list), SortedListEnd(list), 
+		                                                 &keys[targets[i]]));
+	}
+	Stop(measure);
+	
+	SortedListDestroy(list);
+	
+	return ops;
+}
+
+/* This function measures merging two lists of n / 2 keys, per key */
+static size_t SortedMerge(sorted_list_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	sorted_list_t *dest = SortedListCreate(&CmpInt, backend);
+	sorted_list_t *src = SortedListCreate(&CmpInt, backend);
+	size_t i = 0;
+	
+	/* monotonic keys put all of src after dest */
+	for (i = 0; i < n; ++i)
+	{
+		SortedListInsert((i < n / 2) ? (dest) : (src), &keys[i]);
+	}
+	
+	Start(measure);
+	SortedListMerge(dest, src);
+	Stop(measure);
+	
+	SortedListDestroy(dest);
+	SortedListDestroy(src);
+	
+	return n;
+}
+
+/*-----------------Priority Queue-----------------*/
+
+static size_t ListEnqueueRun(int *keys, size_t n, measure_t *measure)
+{
+	return Enqueue(PQ_SORTED_LIST, keys, n, measure);
+}
+
+static size_t ListDequeueRun(int *keys, size_t n, measure_t *measure)
+{
+	return Dequeue(PQ_SORTED_LIST, keys, n, measure);
+}
+
+static size_t ListEraseRun(int *keys, size_t n, measure_t *measure)
+{
+	return Erase(PQ_SORTED_LIST, keys, n, measure);
+}
+
+static size_t HeapEnqueueRun(int *keys, size_t n, measure_t *measure)
+{
+	return Enqueue(PQ_HEAP, keys, n, measure);
+}
+
+static size_t HeapDequeueRun(int *keys, size_t n, measure_t *measure)
+{
+	return Dequeue(PQ_HEAP, keys, n, measure);
+}
+
+static size_t HeapEraseRun(int *keys, size_t n, measure_t *measure)
+{
+	return Erase(PQ_HEAP, keys, n, measure);
+}
+
+/* This function measures enqueueing n keys one by one */
+static size_t Enqueue(pq_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	pq_t *pq = PQCreate(&CmpInt, backend);
+	size_t i = 0;
+	
+	Start(measure);
+	for (i = 0; i < n; ++i)
+	{
+		PQEnqueue(pq, &keys[i]);
+	}
+	Stop(measure);
+	
+	PQDestroy(pq);
+	
+	return n;
+}
+
+/* This function measures dequeueing a queue of n keys until it is empty */
+static size_t Dequeue(pq_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	pq_t *pq = FilledQueue(backend, keys, n);
+	size_t i = 0;
+	
+	Start(measure);
+	for (i = 0; i < n; ++i)
+	{
+		PQDequeue(pq);
+	}
+	Stop(measure);
+	
+	PQDestroy(pq);
+	
+	return n;
+}
+
+/* This function measures erasing random elements of a queue of n keys by a match function */
+static size_t Erase(pq_backend_t backend, int *keys, size_t n, measure_t *measure)
+{
+	pq_t *pq = FilledQueue(backend, keys, n);
+	size_t ops = (n < SEARCH_OPS) ? (n) : (SEARCH_OPS);
+	int *targets[SEARCH_OPS];
+	size_t pick = 0;
+	size_t i = 0;
+	
+	/* distinct elements, a partial shuffle of their addresses */
+	for (i = 0; i < ops; ++i)
+	{
+		targets[i] = &keys[i];
+	}
+	for (i = 0; i < ops; ++i)
+	{
+		pick = (size_t)rand() % n;
+		if (pick < ops)
+		{
+			int *swap = targets[i];
+	
+			targets[i] = targets[pick];
+			targets[pick] = swap;
+		}
+	}
+	
+	Start(measure);
+	for (i = 0; i < ops; ++i)
+	{
+		PQErase(pq, &IsSameData, targets[i]);
+	}
+	Stop(measure);
+	
+	PQDestroy(pq);
+	
+	return ops;
+}
+
+/*-----------------Helpers-----------------*/
+
+/* This function returns a queue holding the n keys */
+static pq_t *FilledQueue(pq_backend_t backend, int *keys, size_t n)
+{
+	pq_t *pq = PQCreate(&CmpInt, backend);
+	size_t i = 0;
+	
+	for (i = 0; i < n; ++i)
+	{
+		PQEnqueue(pq, &keys[i]);
+	}
+	
+	return pq;
+}
+
+/* This function returns a list holding the n keys in their order */
+static dlist_t *FilledList(int *keys, size_t n)
+{
+	dlist_t *list = DListCreate();
+	size_t i = 0;
+	
+	for (i = 0; i < n; ++i)
+	{
+		DListPushEnd(list, &keys[i]);
+	}
+	
+	return list;
+}
+
+/* This function fills n keys in the pattern */
+static void MakeKeys(int *keys, size_t n, key_pattern_t pattern)
+{
+	size_t i = 0;
+	
+	srand(1);
+	for (i = 0; i < n; ++i)
+	{
+		keys[i] = (KEYS_MONOTONIC == pattern) ? ((int)i) : (rand());
+	}
+}
+
+/* This function starts counting time, allocations and cache misses */
+static void Start(measure_t *measure)
+{
+	if (NO_COUNTER != misses_fd)
+	{
+		ioctl(misses_fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(misses_fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+	
+	measure->allocs = n_allocs;
+	measure->ns = MonoTimeNow();
+}
+
+/* This function stops counting and keeps what was counted since Start */
+static void Stop(measure_t *measure)
+{
+	measure->ns = MonoTimeNow() - measure->ns;
+	measure->allocs = n_allocs - measure->allocs;
+	measure->misses = 0;
+	
+	if (NO_COUNTER != misses_fd)
+	{
+		ioctl(misses_fd, PERF_EVENT_IOC_DISABLE, 0);
+		if (sizeof(measure->misses) != read(misses_fd, &measure->misses, sizeof(measure->misses)))
+		{
+			measure->misses = 0;
+		}
+	}
+}
+
+/* This function opens a counter of the cache misses of this process, NO_COUNTER if not allowed */
+static int OpenCacheMisses(void)
+{
+	struct perf_event_attr attr;
+	long fd = 0;
+	
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	
+	fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+	
+	return (0 > fd) ? (NO_COUNTER) : ((int)fd);
+}
+
+static int CmpInt(const void *data1, const void *data2)
+{
+	int key1 = *(const int *)data1;
+	int key2 = *(const int *)data2;
+	
+	return (key1 > key2) - (key1 < key2);
+}
+
+static int IsSameKey(const void *data, const void *param)
+{
+	return (*(const int *)data == *(const int *)param);
+}
+
+static int IsSameData(const void *data, const void *param)
+{
+	return (data == param);
+}
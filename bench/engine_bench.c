@@ -0,0 +1,156 @@
+/************************************************ 
+EXERCISE      : Scheduler engine benchmark
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : engine_bench.c
+*************************************************/
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#include <stdio.h>  /* printf */
+#include <stdlib.h> /* malloc, rand */
+#include <time.h>   /* clock_gettime */
+
+#include "scheduler.h"
+
+#define MAX_DELAY     (3600)  /* seconds */
+#define MAX_CANCELS   (1000)
+#define NS_IN_SEC     (1000000000.0)
+
+static const size_t sizes[] = {1000, 10000, 100000};
+static const char *engine_names[] = {"queue", "wheel"};
+
+static int OneShot(void *param);
+static void NoClean(void *param);
+static double NowSec(void);
+
+static double BenchAdd(sched_engine_t engine, size_t n, ilrd_uid_t *uids);
+static double BenchCancel(sched_engine_t engine, size_t n, ilrd_uid_t *uids);
+static double BenchDispatch(sched_engine_t engine, size_t n);
+
+int main(void)
+{
+	size_t i = 0;
+	size_t n = 0;
+	int engine = 0;
+	ilrd_uid_t *uids = NULL;
+	
+	printf("%-6s %9s %14s %14s %14s\n", "engine", "tasks", "add ns/op", "cancel ns/op", "dispatch ns/op");
+	
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+	{
+		n = sizes[i];
+		
+		uids = (ilrd_uid_t *)malloc(n * sizeof(ilrd_uid_t));
+		if (NULL == uids)
+		{
+			fprintf(stderr, "Memory allocation failed.\n");
+			return EXIT_FAILURE;
+		}
+		
+		for (engine = SCHED_QUEUE; engine <= SCHED_WHEEL; ++engine)
+		{
+			printf("%-6s %9lu %14.1f %14.1f %14.1f\n", engine_names[engine], (unsigned long)n,
+			       BenchAdd((sched_engine_t)engine, n, uids),
+			       BenchCancel((sched_engine_t)engine, n, uids),
+			       BenchDispatch((sched_engine_t)engine, n));
+		}
+		
+		free(uids);
+	}
+	
+	return EXIT_SUCCESS;
+}
+
+/* This function measures adding n tasks with random delays */
+static double BenchAdd(sched_engine_t engine, size_t n, ilrd_uid_t *uids)
+{
+	sched_t *sched = SchedCreate(engine);
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	srand(1);
+	
+	start = NowSec();
+	for (i = 0; i < n; ++i)
+	{
+		uids[i] = SchedAdd(sched, rand() % MAX_DELAY, 1, &OneShot, NULL, NULL, &NoClean);
+	}
+	end = NowSec();
+	
+	SchedDestroy(sched);
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+/* This function measures cancelling random tasks out of n pending ones */
+static double BenchCancel(sched_engine_t engine, size_t n, ilrd_uid_t *uids)
+{
+	sched_t *sched = SchedCreate(engine);
+	size_t cancels = (n < MAX_CANCELS) ? (n) : (MAX_CANCELS);
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	srand(1);
+	
+	for (i = 0; i < n; ++i)
+	{
+		uids[i] = SchedAdd(sched, rand() % MAX_DELAY, 1, &OneShot, NULL, NULL, &NoClean);
+	}
+	
+	start = NowSec();
+	for (i = 0; i < cancels; ++i)
+	{
+		SchedRemove(sched, uids[(size_t)rand() % n]);
+	}
+	end = NowSec();
+	
+	SchedDestroy(sched);
+	
+	return (end - start) * NS_IN_SEC / cancels;
+}
+
+/* This function measures running n one shot tasks that are all due */
+static double BenchDispatch(sched_engine_t engine, size_t n)
+{
+	sched_t *sched = SchedCreate(engine);
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < n; ++i)
+	{
+		SchedAdd(sched, 0, 1, &OneShot, NULL, NULL, &NoClean);
+	}
+	
+	start = NowSec();
+	SchedRun(sched);
+	end = NowSec();
+	
+	SchedDestroy(sched);
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+static int OneShot(void *param)
+{
+	(void)param;
+	
+	return OP_DONE;
+}
+
+static void NoClean(void *param)
+{
+	(void)param;
+}
+
+static double NowSec(void)
+{
+	struct timespec now = {0};
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return now.tv_sec + now.tv_nsec / NS_IN_SEC;
+}
@@ -0,0 +1,349 @@
+/************************************************ 
+EXERCISE      : Scheduler throughput benchmark
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : sched_bench.c
+*************************************************/
+
+#include <stdio.h>  /* printf */
+#include <stdlib.h> /* malloc, rand, qsort, strtoul */
+
+#include "scheduler.h"
+#include "mono_time.h"
+
+#define MIN_TASKS         (100)
+#define MAX_TASKS         (100000)   /* 10^6 runs for minutes, ask for it on the command line */
+#define SPREAD_FACTOR     (2)        /* deadlines this many dispatch costs apart - half load */
+#define MIN_WINDOW_NS     (10000000)
+#define MAX_CALIBRATIONS  (4)        /* doublings of the cost spread for */
+#define BACKLOG_SHARE     (100)      /* a median lateness above window / this is a backlog */
+#define NOT_RUN           ((uint64_t)-1)
+
+/*
+*  prints one CSV line per engine, size and cancel ratio:
+*    add, remove and dispatch cost per task, and the percentiles of how
+*    late the tasks that were not cancelled started.
+*  each case runs twice. first every task is due at once, which measures
+*  the throughput of SchedAddTask, SchedRemove and SchedRun. then the
+*  deadlines are spread SPREAD_FACTOR dispatch costs apart on average, 
+*  starting once all the adds are done, which measures the lateness under
+*  the same load on any machine. a task costs the loop more once the 
+*  deadlines are spread than in an all due batch - a wakeup each and cold
+*  caches - so the cost the spread is sized for, steady_ns, is calibrated 
+*  per engine and size: it starts at the all due cost and doubles while a 
+*  spread run builds up a backlog. the scheduler reads the real monotonic 
+*  clock, the spread keeps each case within seconds, 10^6 tasks take minutes.
+*  a last line tells from which size the wheel adds and dispatches faster
+*  than the queue, the wheel pays for it with up to a tick of lateness.
+*
+*  usage: sched_bench.out [max_tasks], MAX_TASKS by default
+*/
+
+typedef struct bench_record
+{
+	uint64_t deadline;
+	uint64_t lateness;  /* NOT_RUN until the task runs */
+} bench_record_t;
+
+typedef struct bench_result
+{
+	double add_ns;
+	double remove_ns;
+	double dispatch_ns;
+	uint64_t late_p50;
+	uint64_t late_p99;
+	uint64_t late_p999;
+	uint64_t late_max;
+} bench_result_t;
+
+static const double cancel_ratios[] = {0, 0.25, 0.5};
+static const char *engine_names[] = {"queue", "wheel"};
+
+static void BenchThroughput(sched_engine_t engine, size_t n, double ratio,
+                            ilrd_uid_t *uids, bench_result_t *result);
+static void BenchLateness(sched_engine_t engine, size_t n, double ratio, uint64_t lead_ns,
+                          uint64_t window, ilrd_uid_t *uids, bench_record_t *records, 
+                          bench_result_t *result);
+static double SteadyCost(sched_engine_t engine, size_t n, double all_due_ns, uint64_t lead_ns,
+                         ilrd_uid_t *uids, bench_record_t *records);
+static size_t CancelSome(sched_t *sched, ilrd_uid_t *uids, size_t n, double ratio);
+static uint64_t Percentile(const uint64_t *sorted, size_t n, double percent);
+static int Record(void *record);
+static int Nothing(void *param);
+static void NoClean(void *param);
+static int CmpU64(const void *a, const void *b);
+
+int main(int argc, char *argv[])
+{
+	size_t max_tasks = MAX_TASKS;
+	ilrd_uid_t *uids = NULL;
+	bench_record_t *records = NULL;
+	bench_result_t result = {0};
+	double queue_cost = 0;
+	double steady_ns = 0;
+	uint64_t lead_ns = 0;
+	size_t crossover = 0;
+	size_t n = 0;
+	size_t i = 0;
+	int engine = 0;
+	
+	if (1 < argc)
+	{
+		max_tasks = (size_t)strtoul(argv[1], NULL, 10);
+	}
+	
+	uids = (ilrd_uid_t *)malloc(max_tasks * sizeof(ilrd_uid_t));
+	records = (bench_record_t *)malloc(max_tasks * sizeof(bench_record_t));
+	if (NULL == uids || NULL == records)
+	{
+		fprintf(stderr, "Memory allocation failed.\n");
+		free(uids);
+		free(records);
+		return EXIT_FAILURE;
+	}
+	
+	/* the first UID looks the host up, not a cost of the first case */
+	UIDCreate();
+	
+	printf("engine,tasks,cancel_ratio,add_ns,remove_ns,dispatch_ns,steady_ns,"
+	       "late_p50_ns,late_p99_ns,late_p999_ns,late_max_ns\n");
+	
+	for (n = MIN_TASKS; n <= max_tasks; n *= 10)
+	{
+		for (engine = SCHED_QUEUE; engine <= SCHED_WHEEL; ++engine)
+		{
+			for (i = 0; i < sizeof(cancel_ratios) / sizeof(cancel_ratios[0]); ++i)
+			{
+				BenchThroughput((sched_engine_t)engine, n, cancel_ratios[i], uids, &result);
+	
+				/* the first deadline comes well after the last add and remove */
+				lead_ns = (uint64_t)(2 * (result.add_ns + cancel_ratios[i] * result.remove_ns) * n) + NS_IN_MS;
+				if (0 == i)
+				{
+					steady_ns = SteadyCost((sched_engine_t)engine, n, result.dispatch_ns,
+					                       lead_ns, uids, records);
+				}
+				
+				BenchLateness((sched_engine_t)engine, n, cancel_ratios[i], lead_ns,
+				              (uint64_t)(SPREAD_FACTOR * steady_ns * n), uids, records, &result);
+	
+				printf("%s,%lu,%.2f,%.1f,%.1f,%.1f,%.1f,%lu,%lu,%lu,%lu\n", engine_names[engine],
+				       (unsigned long)n, cancel_ratios[i], result.add_ns, result.remove_ns,
+				       result.dispatch_ns, steady_ns, (unsigned long)result.late_p50,
+				       (unsigned long)result.late_p99, (unsigned long)result.late_p999,
+				       (unsigned long)result.late_max);
+				fflush(stdout);
+				
+				/* compared without cancelling, the first size the wheel wins at */
+				if (0 == i && SCHED_QUEUE == engine)
+				{
+					queue_cost = result.add_ns + result.dispatch_ns;
+				}
+				else if (0 == i && 0 == crossover && result.add_ns + result.dispatch_ns < queue_cost)
+				{
+					crossover = n;
+				}
+			}
+		}
+	}
+	
+	if (0 != crossover)
+	{
+		printf("# wheel adds and dispatches faster from %lu tasks, "
+		       "starting tasks up to %lu ns late\n", (unsigned long)crossover, SCHED_WHEEL_TICK_NS);
+	}
+	else
+	{
+		printf("# queue adds and dispatches faster up to %lu tasks\n", (unsigned long)max_tasks);
+	}
+	
+	free(uids);
+	free(records);
+	
+	return EXIT_SUCCESS;
+}
+
+/* This function measures adding n due tasks, cancelling ratio of them and running the rest */
+static void BenchThroughput(sched_engine_t engine, size_t n, double ratio,
+                            ilrd_uid_t *uids, bench_result_t *result)
+{
+	sched_t *sched = SchedCreate(engine);
+	sched_task_desc_t desc = {0};
+	uint64_t start = 0;
+	size_t cancelled = 0;
+	size_t i = 0;
+	
+	desc.oper_func = &Nothing;
+	desc.clean_func = &NoClean;
+	
+	start = MonoTimeNow();
+	for (i = 0; i < n; ++i)
+	{
+		uids[i] = SchedAddTask(sched, &desc);
+	}
+	result->add_ns = (double)(MonoTimeNow() - start) / n;
+	
+	start = MonoTimeNow();
+	cancelled = CancelSome(sched, uids, n, ratio);
+	result->remove_ns = (0 == cancelled) ? (0) : ((double)(MonoTimeNow() - start) / cancelled);
+	
+	start = MonoTimeNow();
+	SchedRun(sched);
+	result->dispatch_ns = (double)(MonoTimeNow() - start) / (n - cancelled);
+	
+	SchedDestroy(sched);
+}
+
+/* This function measures how late n tasks spread over window from lead_ns on start, with ratio of them cancelled */
+static void BenchLateness(sched_engine_t engine, size_t n, double ratio, uint64_t lead_ns,
+                          uint64_t window, ilrd_uid_t *uids, bench_record_t *records, 
+                          bench_result_t *result)
+{
+	sched_t *sched = SchedCreate(engine);
+	sched_task_desc_t desc = {0};
+	uint64_t *lateness = (uint64_t *)records;  /* reused once the tasks ran */
+	uint64_t first = 0;
+	uint64_t now = 0;
+	size_t ran = 0;
+	size_t i = 0;
+	
+	if (window < MIN_WINDOW_NS)
+	{
+		window = MIN_WINDOW_NS;
+	}
+	
+	desc.oper_func = &Record;
+	desc.clean_func = &NoClean;
+	
+	srand(1);
+	first = MonoTimeNow() + lead_ns;
+	for (i = 0; i < n; ++i)
+	{
+		/* RAND_MAX may be 2^31 ns - about 2 s, less than a large window */
+		records[i].deadline = first + (((uint64_t)rand() << 31) ^ (uint64_t)rand()) % window;
+		records[i].lateness = NOT_RUN;
+	
+		now = MonoTimeNow();
+		desc.delay_ns = (records[i].deadline > now) ? (records[i].deadline - now) : (0);
+		desc.oper_params = &records[i];
+		uids[i] = SchedAddTask(sched, &desc);
+	}
+	
+	CancelSome(sched, uids, n, ratio);
+	SchedRun(sched);
+	SchedDestroy(sched);
+	
+	for (i = 0; i < n; ++i)
+	{
+		if (NOT_RUN != records[i].lateness)
+		{
+			lateness[ran] = records[i].lateness;
+			++ran;
+		}
+	}
+	
+	qsort(lateness, ran, sizeof(uint64_t), &CmpU64);
+	result->late_p50 = Percentile(lateness, ran, 50);
+	result->late_p99 = Percentile(lateness, ran, 99);
+	result->late_p999 = Percentile(lateness, ran, 99.9);
+	result->late_max = (0 == ran) ? (0) : (lateness[ran - 1]);
+}
+
+/* This function returns what a run costs the loop once the deadlines of n tasks
+   are spread - the least cost, doubling from the all due one, that a spread
+   run keeps up with */
+static double SteadyCost(sched_engine_t engine, size_t n, double all_due_ns, uint64_t lead_ns,
+                         ilrd_uid_t *uids, bench_record_t *records)
+{
+	bench_result_t pilot = {0};
+	double cost = all_due_ns;
+	uint64_t window = 0;
+	size_t round = 0;
+	
+	for (round = 0; round < MAX_CALIBRATIONS; ++round)
+	{
+		window = (uint64_t)(SPREAD_FACTOR * cost * n);
+		BenchLateness(engine, n, 0, lead_ns, window, uids, records, &pilot);
+		
+		/* an overloaded loop falls further behind with every task. the wheel
+		   starts tasks up to a tick late even when it keeps up */
+		if (pilot.late_p50 < window / BACKLOG_SHARE + SCHED_WHEEL_TICK_NS || window < MIN_WINDOW_NS)
+		{
+			break;
+		}
+		cost *= 2;
+	}
+	
+	return cost;
+}
+
+/* This function removes ratio of the n tasks, picked at random. returns how many */
+static size_t CancelSome(sched_t *sched, ilrd_uid_t *uids, size_t n, double ratio)
+{
+	size_t count = (size_t)(n * ratio);
+	ilrd_uid_t swap = UIDBadUID;
+	size_t pick = 0;
+	size_t i = 0;
+	
+	/* a partial shuffle puts count random uids first */
+	for (i = 0; i < count; ++i)
+	{
+		pick = i + (size_t)rand() % (n - i);
+		swap = uids[i];
+		uids[i] = uids[pick];
+		uids[pick] = swap;
+	}
+	
+	for (i = 0; i < count; ++i)
+	{
+		SchedRemove(sched, uids[i]);
+	}
+	
+	return count;
+}
+
+/* This function returns the value below which percent of the n sorted values are */
+static uint64_t Percentile(const uint64_t *sorted, size_t n, double percent)
+{
+	size_t rank = 0;
+	
+	if (0 == n)
+	{
+		return 0;
+	}
+	
+	rank = (size_t)(percent / 100 * n);
+	
+	return sorted[(rank < n) ? (rank) : (n - 1)];
+}
+
+static int Record(void *record)
+{
+	bench_record_t *self = (bench_record_t *)record;
+	uint64_t now = MonoTimeNow();
+	
+	self->lateness = (now > self->deadline) ? (now - self->deadline) : (0);
+	
+	return OP_DONE;
+}
+
+static int Nothing(void *param)
+{
+	(void)param;
+	
+	return OP_DONE;
+}
+
+static void NoClean(void *param)
+{
+	(void)param;
+}
+
+static int CmpU64(const void *a, const void *b)
+{
+	uint64_t u1 = *(const uint64_t *)a;
+	uint64_t u2 = *(const uint64_t *)b;
+	
+	return (u1 > u2) - (u1 < u2);
+}
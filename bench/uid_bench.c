@@ -0,0 +1,275 @@
+/************************************************ 
+EXERCISE      : UID generator benchmark
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : uid_bench.c
+*************************************************/
+
+#define _POSIX_C_SOURCE 199309L /* clock_gettime */
+#include <stdio.h>      /* printf */
+#include <stdlib.h>     /* malloc, qsort */
+#include <string.h>     /* strcpy, strcmp */
+#include <time.h>       /* clock_gettime */
+#include <unistd.h>     /* getpid */
+#include <pthread.h>    /* pthread_create */
+#include <netinet/in.h> /* inet_ntoa */
+#include <arpa/inet.h>  /* inet_ntoa */
+#include <sys/socket.h> /* struct sockaddr_in */
+#include <ifaddrs.h>    /* getifaddrs */
+
+#include "uid.h"
+
+#define LEGACY_UIDS    (20000)    /* every one costs a netlink round trip */
+#define UIDS           (2000000)
+#define THREADS        (4)
+#define COMPARES       (10000000)
+#define COMPARE_SET    (1024)     /* a power of 2 */
+#define NS_IN_SEC      (1000000000.0)
+
+typedef struct bench_thread
+{
+	pthread_t thread;
+	ilrd_uid_t *uids;  /* the UIDs this thread created */
+	size_t n;
+} bench_thread_t;
+
+static ilrd_legacy_uid_t LegacyUIDCreate(void);
+static double BenchLegacy(size_t n);
+static double BenchCached(size_t n);
+static double BenchCompareLegacy(size_t n);
+static double BenchCompare(size_t n);
+static int LegacyUIDIsSame(ilrd_legacy_uid_t uid1, ilrd_legacy_uid_t uid2);
+static double BenchThreads(size_t n_threads, size_t n, size_t *duplicates);
+static void *CreateMany(void *bench_thread);
+static int CmpUID(const void *uid1, const void *uid2);
+static double NowSec(void);
+
+int main(void)
+{
+	size_t duplicates = 0;
+	
+	printf("%-24s %9s %12s\n", "generator", "uids", "ns/op");
+	printf("%-24s %9lu %12.1f\n", "getifaddrs per uid", (unsigned long)LEGACY_UIDS, BenchLegacy(LEGACY_UIDS));
+	printf("%-24s %9lu %12.1f\n", "cached host", (unsigned long)UIDS, BenchCached(UIDS));
+	printf("%-24s %9lu %12.1f\n", "cached host, 4 threads", (unsigned long)UIDS,
+	       BenchThreads(THREADS, UIDS, &duplicates));
+	printf("%-24s %9lu %12.1f\n", "legacy compare", (unsigned long)COMPARES, BenchCompareLegacy(COMPARES));
+	printf("%-24s %9lu %12.1f\n", "packed compare", (unsigned long)COMPARES, BenchCompare(COMPARES));
+	printf("duplicate uids across threads: %lu\n", (unsigned long)duplicates);
+	
+	return (0 == duplicates) ? (EXIT_SUCCESS) : (EXIT_FAILURE);
+}
+
+/* This function measures the generator UIDCreate had before the host was cached */
+static double BenchLegacy(size_t n)
+{
+	volatile size_t sink = 0;
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	start = NowSec();
+	for (i = 0; i < n; ++i)
+	{
+		sink += LegacyUIDCreate().counter;
+	}
+	end = NowSec();
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+/* This function measures UIDCreate from one thread */
+static double BenchCached(size_t n)
+{
+	volatile size_t sink = 0;
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	start = NowSec();
+	for (i = 0; i < n; ++i)
+	{
+		sink += UIDCreate().lo;
+	}
+	end = NowSec();
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+/* This function measures comparing equal UIDs in the legacy layout, field by field and with strcmp */
+static double BenchCompareLegacy(size_t n)
+{
+	static ilrd_legacy_uid_t uids[COMPARE_SET];
+	volatile size_t sink = 0;
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < COMPARE_SET; ++i)
+	{
+		uids[i] = UIDToLegacy(UIDCreate());
+	}
+	
+	start = NowSec();
+	for (i = 0; i < n; ++i)
+	{
+		sink += LegacyUIDIsSame(uids[i & (COMPARE_SET - 1)], uids[i & (COMPARE_SET - 1)]);
+	}
+	end = NowSec();
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+/* This function measures comparing equal packed UIDs, the case of every hit of a lookup */
+static double BenchCompare(size_t n)
+{
+	static ilrd_uid_t uids[COMPARE_SET];
+	volatile size_t sink = 0;
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < COMPARE_SET; ++i)
+	{
+		uids[i] = UIDCreate();
+	}
+	
+	start = NowSec();
+	for (i = 0; i < n; ++i)
+	{
+		sink += UIDIsSame(uids[i & (COMPARE_SET - 1)], uids[i & (COMPARE_SET - 1)]);
+	}
+	end = NowSec();
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+/* This function measures n UIDCreate calls split between threads, and checks they are unique */
+static double BenchThreads(size_t n_threads, size_t n, size_t *duplicates)
+{
+	bench_thread_t threads[THREADS];
+	ilrd_uid_t *uids = NULL;
+	double start = 0;
+	double end = 0;
+	size_t i = 0;
+	
+	uids = (ilrd_uid_t *)malloc(n * sizeof(ilrd_uid_t));
+	if (NULL == uids)
+	{
+		fprintf(stderr, "Memory allocation failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	
+	start = NowSec();
+	for (i = 0; i < n_threads; ++i)
+	{
+		threads[i].uids = uids + i * (n / n_threads);
+		threads[i].n = n / n_threads;
+		pthread_create(&threads[i].thread, NULL, &CreateMany, &threads[i]);
+	}
+	for (i = 0; i < n_threads; ++i)
+	{
+		pthread_join(threads[i].thread, NULL);
+	}
+	end = NowSec();
+	
+	n = (n / n_threads) * n_threads;
+	qsort(uids, n, sizeof(ilrd_uid_t), &CmpUID);
+	for (i = 1; i < n; ++i)
+	{
+		*duplicates += UIDIsSame(uids[i - 1], uids[i]);
+	}
+	
+	free(uids);
+	
+	return (end - start) * NS_IN_SEC / n;
+}
+
+static void *CreateMany(void *bench_thread)
+{
+	bench_thread_t *self = (bench_thread_t *)bench_thread;
+	size_t i = 0;
+	
+	for (i = 0; i < self->n; ++i)
+	{
+		self->uids[i] = UIDCreate();
+	}
+	
+	return NULL;
+}
+
+/*
+*  UIDCreate as it was: a mutex made and destroyed per call, which guards
+*  nothing, and a getifaddrs and a getpid for every UID.
+*/
+static ilrd_legacy_uid_t LegacyUIDCreate(void)
+{
+	static size_t counter = 0;
+	pthread_mutex_t mutex = {0};
+	ilrd_legacy_uid_t new_uid = {0};
+	struct ifaddrs *ifap = NULL;
+	struct ifaddrs *ifa = NULL;
+	
+	pthread_mutex_init(&mutex, NULL);
+	
+	if (-1 == getifaddrs(&ifap))
+	{
+		pthread_mutex_destroy(&mutex);
+		return new_uid;
+	}
+	for (ifa = ifap; ifa; ifa = ifa->ifa_next)
+	{
+		if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_INET)
+		{
+			strcpy((char *)new_uid.ip, inet_ntoa(((struct sockaddr_in *)ifa->ifa_addr)->sin_addr));
+			break;
+		}
+	}
+	freeifaddrs(ifap);
+	
+	pthread_mutex_lock(&mutex);
+	new_uid.counter = counter;
+	++counter;
+	pthread_mutex_unlock(&mutex);
+	
+	new_uid.time = time(NULL);
+	new_uid.pid = (size_t)getpid();
+	
+	pthread_mutex_destroy(&mutex);
+	
+	return new_uid;
+}
+
+/* UIDIsSame as it was */
+static int LegacyUIDIsSame(ilrd_legacy_uid_t uid1, ilrd_legacy_uid_t uid2)
+{
+	if (uid1.counter != uid2.counter || uid1.time != uid2.time || uid1.pid != uid2.pid)
+	{
+		return 0;
+	}
+	
+	return (0 == strcmp((char *)uid1.ip, (char *)uid2.ip));
+}
+
+static int CmpUID(const void *uid1, const void *uid2)
+{
+	const ilrd_uid_t *u1 = (const ilrd_uid_t *)uid1;
+	const ilrd_uid_t *u2 = (const ilrd_uid_t *)uid2;
+	
+	if (u1->hi != u2->hi)
+	{
+		return (u1->hi > u2->hi) - (u1->hi < u2->hi);
+	}
+	
+	return (u1->lo > u2->lo) - (u1->lo < u2->lo);
+}
+
+static double NowSec(void)
+{
+	struct timespec now = {0};
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	
+	return now.tv_sec + now.tv_nsec / NS_IN_SEC;
+}
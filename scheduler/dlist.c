@@ -12,6 +12,7 @@ File          : dlist.c
 #include <stdlib.h>  /* malloc */
 
 #include "dlist.h" 
+#include "slab.h"
 
 enum status {SUCCESS = 0 , FAILURE = 1};
 
@@ -22,21 +23,33 @@ typedef struct dlist_node
     void *data;
     struct dlist_node *next;
     struct dlist_node *prev;
+    struct dlist *list;  /* the list holding the node, sentinels included */
 } dlist_node_t;
 
 struct dlist
 {
     dlist_node_t head;
     dlist_node_t tail;
+    size_t count;
+    slab_t *pool;  /* where the nodes come from, NULL for malloc */
 };
 
 /* Helper functions */
+#ifndef NDEBUG
 static int Increment(void *nothing , void *counter);
+#endif
 
 static void BounceToEnd(dlist_iter_t iter);
+static void FreeNode(dlist_node_t *node);
 
 /*-----------------DListCreate-----------------*/
 dlist_t *DListCreate(void)
+{
+	return DListCreatePooled(NULL);
+}
+
+/*-----------------DListCreatePooled-----------------*/
+dlist_t *DListCreatePooled(slab_t *pool)
 {
 	dlist_t *list = (dlist_t *)malloc(sizeof(dlist_t));
 	if (NULL == list)
@@ -47,13 +60,25 @@ dlist_t *DListCreate(void)
 	(list -> head).data = NULL;
 	(list -> head).next = &(list -> tail);
 	(list -> head).prev = NULL;
+	(list -> head).list = list;
 	
+	/* an insert before the tail finds the list here */
 	(list -> tail).data = NULL;
 	(list -> tail).next = NULL;
 	(list -> tail).prev = &(list -> head);
+	(list -> tail).list = list;
+	
+	list -> count = 0;
+	list -> pool = pool;
 	
 	return (list);
 }	
+
+/*-----------------DListNodeSize-----------------*/
+size_t DListNodeSize(void)
+{
+	return sizeof(dlist_node_t);
+}
 	
 /*-----------------DListDestroy-----------------*/
 void DListDestroy(dlist_t *list)
@@ -69,12 +94,23 @@ void DListDestroy(dlist_t *list)
 	{
 		temp = runner;
 		runner = runner -> next;
-		free(temp);
+		FreeNode(temp);
 	}
 	
 	free(list);
 }
 
+/*-----------------DListReset-----------------*/
+void DListReset(dlist_t *list)
+{
+	assert(NULL != list);
+	assert(NULL != list -> pool);
+	
+	(list -> head).next = &(list -> tail);
+	(list -> tail).prev = &(list -> head);
+	list -> count = 0;
+}
+
 /*-----------------DListIsEqual-----------------*/
 int DListIsEqual(dlist_iter_t left_iter, dlist_iter_t right_iter)
 {
@@ -139,8 +175,15 @@ dlist_iter_t DListInsert(dlist_iter_t where, void *data)
 	
 	assert(NULL != where);
 	
-	/* memory allocation for the new node */
-	new_node = (dlist_node_t*)malloc(sizeof(dlist_node_t));
+	/* memory allocation for the new node, from the pool of the list if any */
+	if (NULL != where -> list -> pool)
+	{
+		new_node = (dlist_node_t*)SlabAlloc(where -> list -> pool);
+	}
+	else
+	{
+		new_node = (dlist_node_t*)malloc(sizeof(dlist_node_t));
+	}
 	if (NULL == new_node)
 	{
 		BounceToEnd(where); 
@@ -149,6 +192,7 @@ dlist_iter_t DListInsert(dlist_iter_t where, void *data)
 	
 	/* updating values of new node */	
 	new_node -> data = data;
+	new_node -> list = where -> list;
 	new_node -> next = where;
 	new_node -> prev = where -> prev;
 	
@@ -156,6 +200,8 @@ dlist_iter_t DListInsert(dlist_iter_t where, void *data)
 	where -> prev -> next = new_node;	
 	where -> prev = new_node;
 	
+	++(where -> list -> count);
+	
 	return (new_node);
 }
 
@@ -176,8 +222,10 @@ dlist_iter_t DListRemove(dlist_iter_t iter)
 	/* store iterator to be returned */
 	updated_iter = iter -> next;
 	
+	--(iter -> list -> count);
+	
 	/* free deleted iterator */
-	free(iter);
+	FreeNode(iter);
 	
 	return (updated_iter);
 }
@@ -185,18 +233,19 @@ dlist_iter_t DListRemove(dlist_iter_t iter)
 /*-----------------DListCount---------------*/
 size_t DListCount(const dlist_t *list)
 {
-	size_t count = 0;
-	dlist_iter_t begin = NULL;	
-	dlist_iter_t end = NULL;
-
 	assert(NULL != list);
 	
-	begin = DListGetBegin(list);
-	end = DListGetEnd(list);
-	
-	DListForEach(begin , end , &Increment, &count);
+#ifndef NDEBUG
+	{
+		/* the maintained count must match a full walk */
+		size_t count = 0;
+		
+		DListForEach(DListGetBegin(list) , DListGetEnd(list) , &Increment, &count);
+		assert(count == list -> count);
+	}
+#endif
 	
-	return (count); 
+	return (list -> count); 
 }
 
 /*-----------------DListForEach---------------*/
@@ -308,10 +357,26 @@ dlist_iter_t DListSplice(dlist_iter_t from, dlist_iter_t to, dlist_iter_t where)
 	dlist_iter_t old_from_prev = NULL;
 	dlist_iter_t old_to_prev = NULL;
 	dlist_iter_t old_where_prev = NULL;
+	dlist_iter_t runner = NULL;
+	size_t moved = 0;
 	
 	assert(from);
 	assert(to);
 	assert(where);
+	assert(from -> list -> pool == where -> list -> pool);
+	
+	/* nodes changing lists take their new owner and count along */
+	if (from -> list != where -> list)
+	{
+		for (runner = from; runner != to; runner = runner -> next)
+		{
+			runner -> list = where -> list;
+			++moved;
+		}
+		
+		to -> list -> count -= moved;
+		where -> list -> count += moved;
+	}
 	
 
 	/* updating nexts */
@@ -358,6 +423,7 @@ int DListMultiFind(dlist_iter_t from, dlist_iter_t to, match_func_t match_func ,
 	return (DListIsEmpty(output_list)) ? (FAILURE) : (SUCCESS); 
 }
 
+#ifndef NDEBUG
 /* Helper function to increment node count */
 static int Increment(void *nothing , void *counter)
 {
@@ -366,6 +432,7 @@ static int Increment(void *nothing , void *counter)
 	
 	return (SUCCESS);	
 }
+#endif
 
 /* Helper function that bounces to invalid iterator */
 static void BounceToEnd(dlist_iter_t iter)
@@ -377,3 +444,16 @@ static void BounceToEnd(dlist_iter_t iter)
 		iter = iter -> next;
 	}
 }
+
+/* Helper function that returns a node to where it was allocated from */
+static void FreeNode(dlist_node_t *node)
+{
+	if (NULL != node -> list -> pool)
+	{
+		SlabFree(node -> list -> pool, node);
+	}
+	else
+	{
+		free(node);
+	}
+}
@@ -11,6 +11,15 @@ File          : dlist.h
 
 #include <stddef.h>
 
+#include "slab.h"
+
+/*
+*    Every node knows the list holding it, so DListCount, insert and remove
+*    keep the count in O(1). the price is DListSplice between two lists: it
+*    re-tags each moved node, O(k) for k nodes where it used to be O(1).
+*    splicing within one list is still O(1). a caller moving a whole list
+*    into an empty one can swap the two lists instead.
+*/
 typedef struct dlist_node *dlist_iter_t;
 typedef struct dlist dlist_t;
 
@@ -56,6 +65,41 @@ typedef int (*action_func_t)(void *data, void *param);
 dlist_t *DListCreate(void);
 
 
+/*
+*
+*    Creates a new doubly Linked List that takes its nodes from pool instead
+*    of malloc. lists may share a pool, nodes may only be spliced between
+*    lists of the same pool.
+*
+*    Arguments:
+*        pool - slab of elements of at least DListNodeSize() bytes. must be valid.
+*
+*    Return: a pointer to the new doubly Linked List if successful
+*                otherwise return NULL.
+*
+*    Time complexity: O(1) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*
+*/
+dlist_t *DListCreatePooled(slab_t *pool);
+
+
+/*
+*
+*    Size of a node, for creating a pool for DListCreatePooled.
+*
+*    Arguments:
+*        void.
+*
+*    Return: size of a node in bytes.
+*
+*    Time complexity: O(1) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*
+*/
+size_t DListNodeSize(void);
+
+
 /*
 *
 *    Frees all memory allocated for the Doubly Linked List
@@ -72,6 +116,23 @@ dlist_t *DListCreate(void);
 void DListDestroy(dlist_t *list);
 
 
+/*
+*
+*    Empties a pooled list without returning its nodes to the pool. only
+*    for when the pool itself is reset with SlabReset.
+*
+*    Arguments:
+*        list - Pointer to a pooled doubly Linked List. must be a valid address.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*
+*/
+void DListReset(dlist_t *list);
+
+
 /*
 *
 *    Insert a data to the list, before the iterator where. in case of failure
@@ -162,9 +223,10 @@ void *DListGetData(dlist_iter_t iter);
 *    Arguments:
 *        list - Doubly Linked List that count data from. must be a valid list.
 *
-*    Return: how much data stored in list.
+*    Return: how much data stored in list. the count is kept up to date
+*            by every change, debug builds verify it against a full walk.
 *
-*    Time complexity: O(n) best/average/worst
+*    Time complexity: O(1) best/average/worst, O(n) in debug builds
 *    Space complexity: O(1) best/average/worst
 *
 */
@@ -348,7 +410,7 @@ void *DListPopEnd(dlist_t *dlist);
 *
 *    Return: where
 *
-*    Time complexity: O(1) best/average/worst
+*    Time complexity: O(1) within a list, O(k) between lists, k the range size
 *    Space complexity: O(1) best/average/worst
 *
 */
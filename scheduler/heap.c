@@ -0,0 +1,406 @@
+/************************************************ 
+EXERCISE      : DS#13: D-ary Heap
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : heap.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+
+#include "heap.h"
+
+enum status {SUCCESS = 0 , FAILURE = 1};
+
+#define INITIAL_CAPACITY (16)
+#define GROWTH_FACTOR    (2)
+#define ROOT             (0)
+
+#define PARENT(i)        (((i) - 1) / HEAP_ARITY)
+#define FIRST_CHILD(i)   ((i) * HEAP_ARITY + 1)
+
+typedef struct heap_entry
+{
+	void *data;
+	size_t seq;     /* insertion order, breaks ties between equal datas */
+} heap_entry_t;
+
+struct heap
+{
+	heap_entry_t *entries;
+	size_t size;
+	size_t capacity;
+	size_t next_seq;
+	heap_cmp_t cmp;
+	heap_track_t track;   /* NULL if positions are not reported */
+	void *track_param;
+};
+
+/* Helper functions */
+static int IsBefore(const heap_t *heap, const heap_entry_t *e1, const heap_entry_t *e2);
+static void SiftUp(heap_t *heap, size_t index);
+static void SiftDown(heap_t *heap, size_t index);
+static void *RemoveAt(heap_t *heap, size_t index);
+static void Resift(heap_t *heap, size_t index);
+static void Place(heap_t *heap, size_t index, heap_entry_t entry);
+static int Grow(heap_t *heap);
+static int Reserve(heap_t *heap, size_t capacity);
+
+/*-----------------HeapCreate-----------------*/
+heap_t *HeapCreate(heap_cmp_t cmp)
+{
+	return HeapCreateTracked(cmp, NULL, NULL);
+}
+
+/*-----------------HeapCreateTracked-----------------*/
+heap_t *HeapCreateTracked(heap_cmp_t cmp, heap_track_t track, void *param)
+{
+	heap_t *heap = NULL;
+	
+	assert(NULL != cmp);
+	
+	heap = (heap_t *)malloc(sizeof(heap_t));
+	if (NULL == heap)
+	{
+		return NULL;
+	}
+	
+	heap->entries = (heap_entry_t *)malloc(INITIAL_CAPACITY * sizeof(heap_entry_t));
+	if (NULL == heap->entries)
+	{
+		free(heap);
+		return NULL;
+	}
+	
+	heap->size = 0;
+	heap->capacity = INITIAL_CAPACITY;
+	heap->next_seq = 0;
+	heap->cmp = cmp;
+	heap->track = track;
+	heap->track_param = param;
+	
+	return heap;
+}
+
+/*-----------------HeapDestroy-----------------*/
+void HeapDestroy(heap_t *heap)
+{
+	assert(NULL != heap);
+	
+	free(heap->entries);
+	free(heap);
+}
+
+/*-----------------HeapPush-----------------*/
+int HeapPush(heap_t *heap, void *data)
+{
+	assert(NULL != heap);
+	
+	if (heap->size == heap->capacity && SUCCESS != Grow(heap))
+	{
+		return FAILURE;
+	}
+	
+	heap->entries[heap->size].data = data;
+	heap->entries[heap->size].seq = heap->next_seq;
+	++heap->next_seq;
+	++heap->size;
+	
+	SiftUp(heap, heap->size - 1);
+	
+	return SUCCESS;
+}
+
+/*-----------------HeapPushMany-----------------*/
+int HeapPushMany(heap_t *heap, void **datas, size_t count)
+{
+	size_t old_size = 0;
+	size_t i = 0;
+	
+	assert(NULL != heap);
+	assert(NULL != datas || 0 == count);
+	
+	if (0 == count)
+	{
+		return SUCCESS;
+	}
+	
+	if (SUCCESS != Reserve(heap, heap->size + count))
+	{
+		return FAILURE;
+	}
+	
+	old_size = heap->size;
+	for (i = 0; i < count; ++i)
+	{
+		heap->entries[heap->size].data = datas[i];
+		heap->entries[heap->size].seq = heap->next_seq;
+		++heap->next_seq;
+		++heap->size;
+	}
+	
+	/* many new entries - rebuilding bottom up in O(n) beats sifting each */
+	if (1 < heap->size && count * HEAP_ARITY >= heap->size)
+	{
+		for (i = PARENT(heap->size - 1) + 1; i > ROOT; --i)
+		{
+			SiftDown(heap, i - 1);
+		}
+		
+		/* the leaves that stayed in place were never reported */
+		for (i = 0; NULL != heap->track && i < heap->size; ++i)
+		{
+			heap->track(heap->entries[i].data, i, heap->track_param);
+		}
+	}
+	else
+	{
+		for (i = old_size; i < heap->size; ++i)
+		{
+			SiftUp(heap, i);
+		}
+	}
+	
+	return SUCCESS;
+}
+
+/*-----------------HeapPop-----------------*/
+void *HeapPop(heap_t *heap)
+{
+	assert(NULL != heap);
+	assert(0 != heap->size);
+	
+	return RemoveAt(heap, ROOT);
+}
+
+/*-----------------HeapPeek-----------------*/
+void *HeapPeek(const heap_t *heap)
+{
+	assert(NULL != heap);
+	
+	if (0 == heap->size)
+	{
+		return NULL;
+	}
+	
+	return heap->entries[ROOT].data;
+}
+
+/*-----------------HeapRemove-----------------*/
+void *HeapRemove(heap_t *heap, heap_is_match_t is_match, const void *param)
+{
+	size_t i = 0;
+	
+	assert(NULL != heap);
+	assert(NULL != is_match);
+	
+	for (i = 0; i < heap->size; ++i)
+	{
+		if (is_match(heap->entries[i].data, param))
+		{
+			return RemoveAt(heap, i);
+		}
+	}
+	
+	return NULL;
+}
+
+/*-----------------HeapRemoveAt-----------------*/
+void *HeapRemoveAt(heap_t *heap, size_t index)
+{
+	assert(NULL != heap);
+	assert(index < heap->size);
+	
+	return RemoveAt(heap, index);
+}
+
+/*-----------------HeapUpdateAt-----------------*/
+void HeapUpdateAt(heap_t *heap, size_t index)
+{
+	assert(NULL != heap);
+	assert(index < heap->size);
+	
+	heap->entries[index].seq = heap->next_seq;
+	++heap->next_seq;
+	
+	Resift(heap, index);
+}
+
+/*-----------------HeapSize-----------------*/
+size_t HeapSize(const heap_t *heap)
+{
+	assert(NULL != heap);
+	
+	return heap->size;
+}
+
+/*-----------------HeapIsEmpty-----------------*/
+int HeapIsEmpty(const heap_t *heap)
+{
+	assert(NULL != heap);
+	
+	return (0 == heap->size);
+}
+
+/*-----------------HeapClear-----------------*/
+void HeapClear(heap_t *heap)
+{
+	assert(NULL != heap);
+	
+	heap->size = 0;
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function checks if e1 should leave the heap before e2 */
+static int IsBefore(const heap_t *heap, const heap_entry_t *e1, const heap_entry_t *e2)
+{
+	int result = heap->cmp(e1->data, e2->data);
+	
+	return (result > 0 || (0 == result && e1->seq < e2->seq));
+}
+
+/* This function moves the entry at index up until its parent is before it */
+static void SiftUp(heap_t *heap, size_t index)
+{
+	heap_entry_t moving = heap->entries[index];
+	size_t parent = 0;
+	
+	while (ROOT != index)
+	{
+		parent = PARENT(index);
+		if (!IsBefore(heap, &moving, &heap->entries[parent]))
+		{
+			break;
+		}
+		Place(heap, index, heap->entries[parent]);
+		index = parent;
+	}
+	
+	Place(heap, index, moving);
+}
+
+/* This function moves the entry at index down until all its children are after it */
+static void SiftDown(heap_t *heap, size_t index)
+{
+	heap_entry_t moving = heap->entries[index];
+	size_t child = 0;
+	size_t best = 0;
+	size_t last_child = 0;
+	
+	while ((child = FIRST_CHILD(index)) < heap->size)
+	{
+		best = child;
+		last_child = child + HEAP_ARITY;
+		if (last_child > heap->size)
+		{
+			last_child = heap->size;
+		}
+		
+		for (++child; child < last_child; ++child)
+		{
+			if (IsBefore(heap, &heap->entries[child], &heap->entries[best]))
+			{
+				best = child;
+			}
+		}
+		
+		if (!IsBefore(heap, &heap->entries[best], &moving))
+		{
+			break;
+		}
+		Place(heap, index, heap->entries[best]);
+		index = best;
+	}
+	
+	Place(heap, index, moving);
+}
+
+/* This function removes the entry at index and restores the heap order */
+static void *RemoveAt(heap_t *heap, size_t index)
+{
+	void *data = heap->entries[index].data;
+	
+	--heap->size;
+	if (index == heap->size)
+	{
+		return data;
+	}
+	
+	heap->entries[index] = heap->entries[heap->size];
+	Resift(heap, index);
+	
+	return data;
+}
+
+/* This function moves the entry at index up or down to where it belongs */
+static void Resift(heap_t *heap, size_t index)
+{
+	if (ROOT != index && IsBefore(heap, &heap->entries[index], &heap->entries[PARENT(index)]))
+	{
+		SiftUp(heap, index);
+	}
+	else
+	{
+		SiftDown(heap, index);
+	}
+}
+
+/* This function puts entry at index and reports its new position */
+static void Place(heap_t *heap, size_t index, heap_entry_t entry)
+{
+	heap->entries[index] = entry;
+	
+	if (NULL != heap->track)
+	{
+		heap->track(entry.data, index, heap->track_param);
+	}
+}
+
+/* This function enlarges the entries array */
+static int Grow(heap_t *heap)
+{
+	heap_entry_t *entries = NULL;
+	size_t capacity = heap->capacity * GROWTH_FACTOR;
+	
+	entries = (heap_entry_t *)realloc(heap->entries, capacity * sizeof(heap_entry_t));
+	if (NULL == entries)
+	{
+		return FAILURE;
+	}
+	
+	heap->entries = entries;
+	heap->capacity = capacity;
+	
+	return SUCCESS;
+}
+
+/* This function enlarges the entries array to hold at least capacity entries */
+static int Reserve(heap_t *heap, size_t capacity)
+{
+	heap_entry_t *entries = NULL;
+	size_t new_capacity = heap->capacity;
+	
+	if (capacity <= heap->capacity)
+	{
+		return SUCCESS;
+	}
+	
+	while (new_capacity < capacity)
+	{
+		new_capacity *= GROWTH_FACTOR;
+	}
+	
+	entries = (heap_entry_t *)realloc(heap->entries, new_capacity * sizeof(heap_entry_t));
+	if (NULL == entries)
+	{
+		return FAILURE;
+	}
+	
+	heap->entries = entries;
+	heap->capacity = new_capacity;
+	
+	return SUCCESS;
+}
@@ -0,0 +1,242 @@
+/************************************************ 
+EXERCISE      : DS#13: D-ary Heap
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : heap.h
+*************************************************/
+
+#ifndef __HEAP_H__
+#define __HEAP_H__
+
+#include <stddef.h> /* size_t */
+
+/* number of children per node - 4 keeps all siblings in one cache line */
+#define HEAP_ARITY (4)
+
+typedef struct heap heap_t;
+
+/*
+*    Compare function between two datas.
+*
+*    Arguments:
+*        data1 - a data to compare.
+*        data2 - a data to compare.
+*
+*    Return: integer greater than, equal to, or less than zero if data1 should
+*            leave the heap before, together with, or after data2.
+*
+*/
+typedef int (*heap_cmp_t)(const void *data1, const void *data2);
+
+/*
+*    Match function between data and param.
+*
+*    Arguments:
+*        data - the data to do compare.
+*        param - the param to do compare.
+*
+*    Return: 1 if match, otherwise 0.
+*
+*/
+typedef int (*heap_is_match_t)(const void *data, const void *param);
+
+/*
+*    Track function, called whenever a data moves inside the heap.
+*
+*    Arguments:
+*        data - the data that moved.
+*        index - its new position, valid for HeapRemoveAt until the next change.
+*        param - the param given to HeapCreateTracked.
+*
+*/
+typedef void (*heap_track_t)(void *data, size_t index, void *param);
+
+/*
+*	creates a new empty heap
+*
+*	Arguments:
+*		cmp - compare function. can't be NULL.
+*
+*	Return: a new heap if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+heap_t *HeapCreate(heap_cmp_t cmp);
+
+/*
+*	creates a new empty heap that reports where each data moves
+*
+*	Arguments:
+*		cmp - compare function. can't be NULL.
+*		track - called with the new position of every data that moves. 
+*		        NULL reports nothing.
+*		param - passed to track.
+*
+*	Return: a new heap if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+heap_t *HeapCreateTracked(heap_cmp_t cmp, heap_track_t track, void *param);
+
+/*
+*	frees all memory allocated for the heap
+*
+*	Arguments:
+*		heap - heap to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void HeapDestroy(heap_t *heap);
+
+/*
+*	insert data to the heap. in case of failure the heap remain unchanged.
+*	datas that compare equal leave the heap in insertion order.
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*		data - the data to insert.
+*
+*	Return: 0 - success,
+*			1 - failure.
+*
+*	Time complexity: O(1) best, O(log n) average/worst
+*	Space complexity: O(1) amortized
+*/
+int HeapPush(heap_t *heap, void *data);
+
+/*
+*	insert count datas to the heap at once. either all are inserted or,
+*	in case of failure, none. datas that compare equal leave the heap in 
+*	insertion order, the array order counts as insertion order.
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*		datas - array of the datas to insert. must be valid.
+*		count - number of datas in the array.
+*
+*	Return: 0 - success,
+*			1 - failure.
+*
+*	Time complexity: O(k log n) or O(n + k) worst, whichever is smaller
+*	Space complexity: O(k) amortized
+*/
+int HeapPushMany(heap_t *heap, void **datas, size_t count);
+
+/*
+*	remove the top data of the heap
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid and not empty.
+*
+*	Return: the removed data.
+*
+*	Time complexity: O(log n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *HeapPop(heap_t *heap);
+
+/*
+*	get the top data of the heap
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*
+*	Return: the top data, or NULL if the heap is empty.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *HeapPeek(const heap_t *heap);
+
+/*
+*	remove the first data that matches param
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*		is_match - boolean match function. can't be NULL.
+*		param - the param to match.
+*
+*	Return: the removed data, or NULL if not found.
+*
+*	Time complexity: O(n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *HeapRemove(heap_t *heap, heap_is_match_t is_match, const void *param);
+
+/*
+*	remove the data at a position reported by the track function
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*		index - the last position reported for the data. must be in the heap.
+*
+*	Return: the removed data.
+*
+*	Time complexity: O(log n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *HeapRemoveAt(heap_t *heap, size_t index);
+
+/*
+*	restore the heap order after the key of the data at a position changed.
+*	the data is ordered after the datas with an equal key, as if just pushed.
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*		index - the last position reported for the data. must be in the heap.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best, O(log n) average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void HeapUpdateAt(heap_t *heap, size_t index);
+
+/*
+*	Return the number of datas in the heap
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*
+*	Return: number of datas in the heap.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t HeapSize(const heap_t *heap);
+
+/*
+*	Checks if the heap is empty
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*
+*	Return: 1 - if the heap is empty, 0 - otherwise
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+int HeapIsEmpty(const heap_t *heap);
+
+/*
+*	Remove all the datas from the heap, keeping its storage
+*
+*	Arguments:
+*		heap - pointer to the heap. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void HeapClear(heap_t *heap);
+
+#endif /* __HEAP_H__ */
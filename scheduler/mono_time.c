@@ -0,0 +1,39 @@
+/************************************************ 
+EXERCISE      : Monotonic Time
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : mono_time.c
+*************************************************/
+
+#define _POSIX_C_SOURCE 200112L /* clock_nanosleep */
+#include <time.h>   /* clock_gettime, clock_nanosleep */
+#include <errno.h>  /* EINTR */
+#include <assert.h> /* assert */
+
+#include "mono_time.h"
+
+uint64_t MonoTimeNow(void)
+{
+	struct timespec now = {0};
+	int status = 0;
+	
+	status = clock_gettime(CLOCK_MONOTONIC, &now);
+	assert(0 == status);
+	(void)status;
+	
+	return (uint64_t)now.tv_sec * NS_IN_SEC + (uint64_t)now.tv_nsec;
+}
+
+void MonoTimeSleepUntil(uint64_t deadline)
+{
+	struct timespec wakeup = {0};
+	
+	wakeup.tv_sec = (time_t)(deadline / NS_IN_SEC);
+	wakeup.tv_nsec = (long)(deadline % NS_IN_SEC);
+	
+	/* interrupted sleeps resume towards the same absolute deadline */
+	while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, NULL))
+	{
+	}
+}
@@ -0,0 +1,46 @@
+/************************************************ 
+EXERCISE      : Monotonic Time
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : mono_time.h
+*************************************************/
+
+#ifndef __MONO_TIME_H__
+#define __MONO_TIME_H__
+
+#include <stdint.h> /* uint64_t */
+
+#define NS_IN_SEC  (1000000000UL)
+#define NS_IN_MS   (1000000UL)
+#define NS_IN_US   (1000UL)
+
+/*
+*	Get the current time of the monotonic clock. the clock is not affected
+*	by changes of the wall clock and has no meaning across processes.
+*
+*	Arguments: None.
+*
+*	Return: the current monotonic time in nanoseconds.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+uint64_t MonoTimeNow(void);
+
+/*
+*	Sleep until the monotonic clock reaches deadline. the deadline is 
+*	absolute, so time spent before the call or in signal handlers does not
+*	delay the wakeup. returns at once if deadline has passed.
+*
+*	Arguments:
+*		deadline - monotonic time in nanoseconds.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void MonoTimeSleepUntil(uint64_t deadline);
+
+#endif /* __MONO_TIME_H__ */
@@ -0,0 +1,100 @@
+/************************************************ 
+EXERCISE      : DS#15: Multi Producer Single Consumer Queue
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : mpsc_queue.c
+*************************************************/
+
+#include <stddef.h>    /* NULL */
+#include <stdint.h>    /* uintptr_t */
+#include <assert.h>    /* assert */
+#include <stdlib.h>    /* malloc */
+#include <stdatomic.h> /* atomic_uintptr_t */
+
+#include "mpsc_queue.h"
+
+/* 
+*  producers push to a lock free stack. the consumer detaches the whole stack
+*  at once and reverses it into its private ready list. detaching everything
+*  means a node is never popped from under a producer, so there is no ABA.
+*/
+struct mpsc_queue
+{
+	atomic_uintptr_t pushed;  /* mpsc_node_t *, newest first */
+	mpsc_node_t *ready;       /* consumer only, oldest first */
+};
+
+/*-----------------MPSCCreate-----------------*/
+mpsc_t *MPSCCreate(void)
+{
+	mpsc_t *queue = (mpsc_t *)malloc(sizeof(mpsc_t));
+	if (NULL == queue)
+	{
+		return NULL;
+	}
+	
+	atomic_init(&queue->pushed, (uintptr_t)NULL);
+	queue->ready = NULL;
+	
+	return queue;
+}
+
+/*-----------------MPSCDestroy-----------------*/
+void MPSCDestroy(mpsc_t *queue)
+{
+	assert(NULL != queue);
+	
+	free(queue);
+}
+
+/*-----------------MPSCPush-----------------*/
+void MPSCPush(mpsc_t *queue, mpsc_node_t *node, int *was_empty)
+{
+	uintptr_t head = 0;
+	
+	assert(NULL != queue);
+	assert(NULL != node);
+	
+	head = atomic_load(&queue->pushed);
+	do
+	{
+		node->next = (mpsc_node_t *)head;
+	}
+	while (!atomic_compare_exchange_weak(&queue->pushed, &head, (uintptr_t)node));
+	
+	if (NULL != was_empty)
+	{
+		*was_empty = ((uintptr_t)NULL == head);
+	}
+}
+
+/*-----------------MPSCPop-----------------*/
+mpsc_node_t *MPSCPop(mpsc_t *queue)
+{
+	mpsc_node_t *node = NULL;
+	mpsc_node_t *next = NULL;
+	
+	assert(NULL != queue);
+	
+	if (NULL == queue->ready && (uintptr_t)NULL != atomic_load(&queue->pushed))
+	{
+		/* detach everything pushed so far and turn it into oldest first */
+		node = (mpsc_node_t *)atomic_exchange(&queue->pushed, (uintptr_t)NULL);
+		while (NULL != node)
+		{
+			next = node->next;
+			node->next = queue->ready;
+			queue->ready = node;
+			node = next;
+		}
+	}
+	
+	node = queue->ready;
+	if (NULL != node)
+	{
+		queue->ready = node->next;
+	}
+	
+	return node;
+}
@@ -0,0 +1,85 @@
+/************************************************ 
+EXERCISE      : DS#15: Multi Producer Single Consumer Queue
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : mpsc_queue.h
+*************************************************/
+
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+#include <stddef.h> /* NULL */
+
+typedef struct mpsc_queue mpsc_t;
+
+/* 
+*  the queue links the pushed datas through a node embedded in them, so
+*  pushing never allocates. place it as the first member of the data struct
+*  and cast the popped node back to it.
+*/
+typedef struct mpsc_node
+{
+	struct mpsc_node *next;
+} mpsc_node_t;
+
+/*
+*	creates a new empty lock free queue. any number of threads may push,
+*	a single thread at a time may pop.
+*
+*	Arguments: None.
+*
+*	Return: a new queue if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+mpsc_t *MPSCCreate(void);
+
+/*
+*	frees all memory allocated for the queue. datas still queued are not freed.
+*	no thread may use the queue during or after the call.
+*
+*	Arguments:
+*		queue - queue to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void MPSCDestroy(mpsc_t *queue);
+
+/*
+*	add data to the end of the queue. may be called from any thread.
+*	datas pushed by the same thread are popped in the order they were pushed.
+*
+*	Arguments:
+*		queue - pointer to the queue. must be valid.
+*		node - the node embedded in the data to push. must be valid and not queued.
+*		was_empty - if not NULL, set to 1 if data is the first data pushed
+*		            since the consumer last took the pushed datas, meaning 
+*		            the consumer may need to be notified. otherwise 0.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average, lock free
+*	Space complexity: O(1) best/average/worst
+*/
+void MPSCPush(mpsc_t *queue, mpsc_node_t *node, int *was_empty);
+
+/*
+*	remove the data at the front of the queue. consumer thread only.
+*
+*	Arguments:
+*		queue - pointer to the queue. must be valid.
+*
+*	Return: the node of the removed data, or NULL if the queue is empty.
+*
+*	Time complexity: O(1) amortized, wait free
+*	Space complexity: O(1) best/average/worst
+*/
+mpsc_node_t *MPSCPop(mpsc_t *queue);
+
+#endif /* __MPSC_QUEUE_H__ */
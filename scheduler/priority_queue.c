@@ -10,20 +10,35 @@ File          : priority_queue.c
 #include <stdlib.h>
 
 #include "priority_queue.h"
+#include "heap.h"
 
 enum status {SUCCESS = 0 , FAILURE = 1};
 
 struct priority_queue 
 {
-	sorted_list_t *priority_queue;
+	pq_backend_t backend;
+	sorted_list_t *priority_queue; /* PQ_SORTED_LIST */
+	heap_t *heap;                  /* PQ_HEAP */
+	pq_track_t track;              /* NULL if positions are not reported */
 };
 
+/* Helper functions */
+static void TrackInHeap(void *data, size_t index, void *pq);
+static void TrackInList(pq_t *pq, void *data, sorted_list_iter_t where);
 
-pq_t *PQCreate(pq_compare_t cmp)
+
+
+pq_t *PQCreate(pq_compare_t cmp, pq_backend_t backend)
+{
+	return PQCreateTracked(cmp, backend, NULL);
+}
+
+pq_t *PQCreateTracked(pq_compare_t cmp, pq_backend_t backend, pq_track_t track)
 {	
 	pq_t *pq = NULL;
 	
 	assert(NULL != cmp);
+	assert(PQ_SORTED_LIST == backend || PQ_HEAP == backend);
 	
 	pq = (pq_t *)malloc(sizeof(pq_t));
 	if (NULL == pq)
@@ -31,7 +46,24 @@ pq_t *PQCreate(pq_compare_t cmp)
 		return NULL;
 	}
 	
-	pq->priority_queue = SortedListCreate(cmp);
+	pq->backend = backend;
+	pq->priority_queue = NULL;
+	pq->heap = NULL;
+	pq->track = track;
+	
+	if (PQ_HEAP == backend)
+	{
+		pq->heap = HeapCreateTracked(cmp, (NULL != track) ? (&TrackInHeap) : (NULL), pq);
+		if (NULL == pq->heap)
+		{
+			free(pq);
+			return NULL;
+		}
+		
+		return pq;
+	}
+	
+	pq->priority_queue = SortedListCreate(cmp, SORTED_LIST_DLIST);
 	if (NULL == pq->priority_queue)
 	{
 		free(pq);
@@ -44,8 +76,15 @@ pq_t *PQCreate(pq_compare_t cmp)
 void PQDestroy(pq_t *pq)
 {
 	assert(NULL != pq);
-		
-	SortedListDestroy(pq->priority_queue);
+	
+	if (PQ_HEAP == pq->backend)
+	{
+		HeapDestroy(pq->heap);
+	}
+	else
+	{
+		SortedListDestroy(pq->priority_queue);
+	}
 	free(pq);
 }
 
@@ -56,6 +95,11 @@ int PQEnqueue(pq_t *pq, void *data)
 
 	assert(NULL != pq);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapPush(pq->heap, data);
+	}
+	
 	result_iter = SortedListInsert(pq->priority_queue , data);
 	end = SortedListEnd(pq->priority_queue);
 	
@@ -63,9 +107,41 @@ int PQEnqueue(pq_t *pq, void *data)
 	{
 		return (FAILURE);
 	}
+	
+	TrackInList(pq, data, result_iter);
+	
 	return (SUCCESS); 
 }
 
+size_t PQEnqueueMany(pq_t *pq, void **datas, size_t count)
+{
+	sorted_list_iter_t where = {NULL};
+	size_t i = 0;
+	
+	assert(NULL != pq);
+	assert(NULL != datas || 0 == count);
+	
+	if (PQ_HEAP == pq->backend)
+	{
+		return (SUCCESS == HeapPushMany(pq->heap, datas, count)) ? (count) : (0);
+	}
+	
+	/* each data is searched for from the last one - O(1) for a sorted array */
+	where = SortedListBegin(pq->priority_queue);
+	for (i = 0; i < count; ++i)
+	{
+		where = SortedListInsertHint(pq->priority_queue, where, datas[i]);
+		if (SortedListIsEqual(where, SortedListEnd(pq->priority_queue)))
+		{
+			break;
+		}
+		
+		TrackInList(pq, datas[i], where);
+	}
+	
+	return i;
+}
+
 void *PQDequeue(pq_t *pq)
 {
 	void *data = NULL;
@@ -74,6 +150,11 @@ void *PQDequeue(pq_t *pq)
 	
 	if (!PQIsEmpty(pq))
 	{
+		if (PQ_HEAP == pq->backend)
+		{
+			return HeapPop(pq->heap);
+		}
+		
 		data = PQPeek(pq);
 		SortedListPopBack(pq->priority_queue);
 	}
@@ -87,6 +168,11 @@ void *PQPeek(const pq_t *pq)
 
 	assert(NULL != pq);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapPeek(pq->heap);
+	}
+	
 	last_valid_iter = SortedListPrev(SortedListEnd(pq->priority_queue));
 
 	return SortedListGetData(last_valid_iter);
@@ -97,6 +183,11 @@ int PQIsEmpty(const pq_t *pq)
 {
 	assert(NULL != pq);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapIsEmpty(pq->heap);
+	}
+	
 	return SortedListIsEmpty(pq->priority_queue);
 }
 
@@ -104,6 +195,11 @@ size_t PQGetSize(const pq_t *pq)
 {
 	assert(NULL != pq);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapSize(pq->heap);
+	}
+	
 	return SortedListSize(pq->priority_queue);
 }
 
@@ -112,6 +208,12 @@ void PQClear(pq_t *pq)
 {
 	assert(NULL != pq);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		HeapClear(pq->heap);
+		return;
+	}
+	
 	while (!SortedListIsEmpty(pq->priority_queue))
 	{
 		SortedListPopBack(pq->priority_queue);
@@ -123,11 +225,17 @@ void *PQErase(pq_t *pq, pq_is_match_t func, void *param)
 	sorted_list_iter_t where = {NULL};
 	sorted_list_iter_t begin = {NULL};
 	sorted_list_iter_t end = {NULL};	
+	void *data = NULL;
 		
 	assert(NULL != pq);
 	assert(NULL != func);
 	assert(NULL != param);
 	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapRemove(pq->heap, func, param);
+	}
+	
 	begin = SortedListBegin(pq->priority_queue);
 	end = SortedListEnd(pq->priority_queue);
 	
@@ -135,10 +243,71 @@ void *PQErase(pq_t *pq, pq_is_match_t func, void *param)
                              
 	if (!SortedListIsEqual(where , end))
 	{
-		param = SortedListGetData(where);	
+		data = SortedListGetData(where);	
 		SortedListRemove(where);
 	}
 	
-	return param;
+	return data;
 }
 
+void *PQEraseAt(pq_t *pq, pq_handle_t handle)
+{
+	sorted_list_iter_t where = {NULL};
+	void *data = NULL;
+	
+	assert(NULL != pq);
+	assert(NULL != pq->track);
+	
+	if (PQ_HEAP == pq->backend)
+	{
+		return HeapRemoveAt(pq->heap, handle.index);
+	}
+	
+	where.internal_iter = handle.node;
+	where.list = pq->priority_queue;
+	
+	data = SortedListGetData(where);
+	SortedListRemove(where);
+	
+	return data;
+}
+
+void PQUpdateAt(pq_t *pq, pq_handle_t handle)
+{
+	sorted_list_iter_t where = {NULL};
+	
+	assert(NULL != pq);
+	assert(NULL != pq->track);
+	
+	if (PQ_HEAP == pq->backend)
+	{
+		HeapUpdateAt(pq->heap, handle.index);
+		return;
+	}
+	
+	where.internal_iter = handle.node;
+	where.list = pq->priority_queue;
+	
+	SortedListUpdate(pq->priority_queue, where);
+}
+
+/* This function reports where data entered the list. list nodes stay put, reporting them once is enough */
+static void TrackInList(pq_t *pq, void *data, sorted_list_iter_t where)
+{
+	pq_handle_t handle = {0};
+	
+	if (NULL != pq->track)
+	{
+		handle.node = where.internal_iter;
+		pq->track(data, handle);
+	}
+}
+
+/* This function reports a move of data inside the heap as a queue handle */
+static void TrackInHeap(void *data, size_t index, void *pq)
+{
+	pq_handle_t handle = {0};
+	
+	handle.index = index;
+	((pq_t *)pq)->track(data, handle);
+}
@@ -28,12 +28,56 @@ typedef int (*pq_compare_t)(const void *data_1, const void *data_2);
 
 typedef struct priority_queue pq_t;
 
+/* the storage behind the queue */
+typedef enum pq_backend
+{
+	PQ_SORTED_LIST, /* sorted doubly linked list - O(n) enqueue */
+	PQ_HEAP         /* array backed d-ary heap - O(log n) enqueue/dequeue */
+} pq_backend_t;
+
+/* where a data sits in the queue, reported through pq_track_t */
+typedef struct pq_handle
+{
+	size_t index;  /* PQ_HEAP - changes whenever the data moves */
+	void *node;    /* PQ_SORTED_LIST - fixed until the data leaves */
+} pq_handle_t;
+
+/*
+*    Track function, called whenever a data enters or moves inside the queue.
+*
+*    Arguments:
+*        data - the data that moved.
+*        handle - its new position, valid for PQEraseAt until the next change.
+*
+*/
+typedef void (*pq_track_t)(void *data, pq_handle_t handle);
+
 /*
 *
 *	creates a new Queue
 *
 *	Arguments:
 *		cmp - compare function.
+*		backend - the storage to use, PQ_SORTED_LIST or PQ_HEAP.
+*
+*	Return: a new priority Queue if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*
+*/
+pq_t *PQCreate(pq_compare_t cmp, pq_backend_t backend);
+
+/*
+*
+*	creates a new Queue that reports where each data is, for PQEraseAt
+*
+*	Arguments:
+*		cmp - compare function.
+*		backend - the storage to use, PQ_SORTED_LIST or PQ_HEAP.
+*		track - called with the handle of every data that enters or moves.
+*		        NULL reports nothing, like PQCreate.
 *
 *	Return: a new priority Queue if successful
 *				otherwise return NULL.
@@ -42,7 +86,7 @@ typedef struct priority_queue pq_t;
 *	Space complexity: O(1) best/average/worst
 *
 */
-pq_t *PQCreate(pq_compare_t cmp);
+pq_t *PQCreateTracked(pq_compare_t cmp, pq_backend_t backend, pq_track_t track);
 
 /*
 *
@@ -71,12 +115,34 @@ void PQDestroy(pq_t *pq);
 *	Return: 0 - success,
 *			1- failure.
 *
-*	Time complexity: O(n) best/average, O(n) - worst
+*	Time complexity: list: O(n) best/average/worst
+*					 heap: O(1) best, O(log n) average/worst
 *	Space complexity: O(1) best/average/worst
 *
 */
 int PQEnqueue(pq_t *pq, void *data);
 
+/*
+*
+*	add count values to the Queue, in the order of the array.
+*
+*	Arguments:
+*		pq - pointer to the queue to change. must be vaild.
+*		datas - array of the values to add. must be valid.
+*		count - number of values in the array.
+*
+*
+*	Return: number of values added. on failure the values from that index
+*			on are not in the Queue. the heap adds all of them or none.
+*
+*	Time complexity: list: O(k * n) worst, O(k) best when the array is 
+*					       sorted, either way
+*					 heap: O(min(k log n, n + k)) worst
+*	Space complexity: O(k) amortized
+*
+*/
+size_t PQEnqueueMany(pq_t *pq, void **datas, size_t count);
+
 /*
 *
 *	remove a value from the front of the Queue
@@ -86,7 +152,8 @@ int PQEnqueue(pq_t *pq, void *data);
 *
 *	Return: data of dequeued element.
 *
-*	Time complexity: O(1) best/average/worst
+*	Time complexity: list: O(1) best/average/worst
+*					 heap: O(log n) best/average/worst
 *	Space complexity: O(1) best/average/worst
 *
 */
@@ -131,7 +198,7 @@ int PQIsEmpty(const pq_t *pq);
 *
 *	Return: number of values in the queue 
 *
-*	Time complexity: O(n) best/average/worst
+*	Time complexity: O(1) best/average/worst
 *	Space complexity: O(1) best/average/worst
 *
 */
@@ -161,7 +228,7 @@ void PQClear(pq_t *pq);
 *		pq - pointer to the queue to search for the data. must be vaild.
 *		func - boolean match function
 		param - the param to match
-*	Return: Erased data. 
+*	Return: Erased data, or NULL if no element matched. 
 *
 *	Time complexity: O(n) best/average/worst
 *	Space complexity: O(1) best/average/worst
@@ -169,5 +236,38 @@ void PQClear(pq_t *pq);
 */
 void *PQErase(pq_t *pq, pq_is_match_t func, void *param);
 
+/*
+*
+*	Erase an element by the last handle reported for it
+*
+*	Arguments:
+*		pq - pointer to a queue created by PQCreateTracked. must be vaild.
+*		handle - the last handle reported for the element. must be in the queue.
+*
+*	Return: Erased data. 
+*
+*	Time complexity: O(1) for PQ_SORTED_LIST, O(log n) for PQ_HEAP
+*	Space complexity: O(1) best/average/worst
+*
+*/
+void *PQEraseAt(pq_t *pq, pq_handle_t handle);
+
+/*
+*
+*	Move an element to its place after its priority changed. the element
+*	keeps its handle in PQ_SORTED_LIST, PQ_HEAP reports the new one.
+*
+*	Arguments:
+*		pq - pointer to a queue created by PQCreateTracked. must be vaild.
+*		handle - the last handle reported for the element. must be in the queue.
+*
+*	Return: void.
+*
+*	Time complexity: O(n) for PQ_SORTED_LIST, O(log n) for PQ_HEAP
+*	Space complexity: O(1) best/average/worst
+*
+*/
+void PQUpdateAt(pq_t *pq, pq_handle_t handle);
+
 
 #endif /* __PRIORIT_QUEUE_H__ */
@@ -6,52 +6,298 @@ Date          : 22/5/2023
 File          : scheduler.c
 *************************************************/
 
-#include <stdlib.h> /* malloc */
-#include <assert.h> /* assert */
-#include <unistd.h> /* sleep */
+#define _POSIX_C_SOURCE 200112L /* poll, read, write */
+#include <stdlib.h>       /* malloc */
+#include <limits.h>       /* CHAR_BIT */
+#include <assert.h>       /* assert */
+#include <stdatomic.h>    /* atomic_int */
+#include <errno.h>        /* errno */
+#include <pthread.h>      /* pthread_create, pthread_self */
+#include <semaphore.h>    /* sem_t */
+#include <time.h>         /* clock_gettime */
+#include <unistd.h>       /* read, write, close */
+#include <poll.h>         /* poll */
+#include <sys/eventfd.h>  /* eventfd */
+#include <sys/timerfd.h>  /* timerfd_create, timerfd_settime */
 
 #include "scheduler.h"
 #include "uid.h"
+#include "uid_index.h"
 #include "priority_queue.h"
+#include "timing_wheel.h"
+#include "mpsc_queue.h"
+#include "work_deque.h"
+#include "dlist.h"
+#include "slab.h"
 #include "task.h"
+#include "mono_time.h"
+
+/* a thread of SchedRunParallel */
+typedef struct sched_worker
+{
+	sched_t *sched;
+	work_deque_t *jobs;  /* sched_cmd_t handed to this worker */
+	pthread_t thread;
+	size_t id;
+} sched_worker_t;
 
 struct scheduler
 {
-	pq_t *pq;
-	int to_stop; 
+	sched_engine_t engine;
+	pq_t *pq;          /* SCHED_QUEUE */
+	tw_t *wheel;       /* SCHED_WHEEL */
+	uid_index_t *index;         /* uid -> task, for every task the owner accepted */
+	slab_t *task_pool;          /* tasks added by the thread owning the scheduler */
+	atomic_ulong n_unpooled;    /* tasks allocated with malloc by other threads */
+	atomic_int to_stop; 
 	task_t *current_task;
 	int to_remove_current;
+	task_t **batch;             /* the due tasks SchedRun is running, NULL once gone */
+	size_t batch_size;
+	size_t batch_capacity;
+	int wake_fd;                /* eventfd, written to interrupt a waiting SchedRun */
+	int timer_fd;               /* timerfd armed with the next deadline */
+	mpsc_t *commands;           /* sched_cmd_t submitted by other threads */
+	atomic_int is_running;      /* released after run_thread is set */
+	pthread_t run_thread;       /* valid while is_running */
+	atomic_ulong n_tasks;       /* tasks added and not destroyed yet */
+	atomic_ulong n_missed;      /* sched_overrun_stats_t */
+	atomic_ulong n_coalesced;
+	atomic_ulong n_runs;        /* sched_stats_t, written by the owner thread only */
+	atomic_ulong n_wakeups;
+	atomic_ulong loop_ns;
+	atomic_ulong busy_ns;
+	atomic_ulong idle_ns;
+	atomic_ulong run_hist[SCHED_HIST_BUCKETS];
+	atomic_ulong lateness_hist[SCHED_HIST_BUCKETS];
+	sched_worker_t *workers;    /* SchedRunParallel only */
+	size_t n_workers;
+	size_t next_worker;         /* round robin target of the next job */
+	dlist_t *in_flight;         /* jobs handed to the workers and not done */
+	atomic_ulong n_queued;      /* jobs waiting in the deques */
+	atomic_ulong n_idle;        /* workers waiting for jobs */
+	atomic_int workers_stop;
+	pthread_mutex_t idle_lock;
+	pthread_cond_t idle_cond;
 };
 
 enum boolean_status {FALSE = 0 , TRUE = 1};
 
+/* task_handle_t holder - where a task of the scheduler is */
+enum task_holder
+{
+	HELD_BY_ENGINE,  /* queued, index is its heap slot, node its wheel node */
+	HELD_BY_BATCH,   /* due in SchedRun, index is its slot in the batch */
+	HELD_BY_WORKER   /* due in SchedRunParallel, node is its sched_cmd_t */
+};
+
+#define INITIAL_BATCH_CAPACITY (16)
+#define TASKS_PER_BLOCK        (64)
+
+/* waits with no deadline, for a SchedRunParallel with only running tasks */
+#define WAIT_FOREVER (UINT64_MAX)
+
+/* 
+*  a change requested by a thread other than the one running SchedRun.
+*  CMD_DONE is a task handed to a worker of SchedRunParallel, it comes 
+*  back through the same queue once the task ran.
+*/
+typedef enum cmd_type
+{
+	CMD_ADD,
+	CMD_REMOVE,
+	CMD_RESCHEDULE,
+	CMD_SET_INTERVAL,
+	CMD_GET_STATS,
+	CMD_CLEAR,
+	CMD_DONE
+} cmd_type_t;
+
+/* 
+*  a SchedGetTaskStats of another thread. the asker may stop waiting for
+*  a SchedRun that returned, so the last of the asker and the owner thread
+*  to let go of it frees it.
+*/
+typedef struct sched_query
+{
+	sched_task_stats_t stats;
+	int status;
+	sem_t answered;
+	atomic_int refs;
+} sched_query_t;
+
+/* how long an unanswered query waits before it checks if SchedRun returned */
+#define QUERY_POLL_NS (10 * NS_IN_MS)
+
+typedef struct sched_cmd
+{
+	mpsc_node_t node;        /* must be first */
+	cmd_type_t type;
+	task_t *task;            /* CMD_ADD, CMD_DONE */
+	ilrd_uid_t uid;          /* CMD_REMOVE, CMD_RESCHEDULE, CMD_SET_INTERVAL, CMD_GET_STATS */
+	uint64_t ns;             /* CMD_RESCHEDULE: the new time, CMD_SET_INTERVAL: the interval */
+	sched_query_t *query;    /* CMD_GET_STATS */
+	int status;              /* CMD_DONE: what the task returned */
+	uint64_t started;        /* CMD_DONE: when the run started, 0 if it did not run */
+	uint64_t ended;          /* CMD_DONE: when the run ended */
+	atomic_int cancelled;    /* CMD_DONE: removed after it was handed over */
+	atomic_int deferred;     /* CMD_DONE: rescheduled after it was handed over */
+	dlist_iter_t where;      /* CMD_DONE: position in in_flight */
+} sched_cmd_t;
+
 /*--------------- Compare Function--------------------*/
 static int TaskCmp(const void *task1, const void *task2);
 
-/*--------------- Match Function--------------------*/
-static int IsMatch(const void *task, const void *uid);
+/*--------------- Track Function--------------------*/
+static void TrackInQueue(void *task, pq_handle_t handle);
+
+/*--------------- Wheel Tick Function--------------------*/
+static tw_tick_t TaskTick(const void *task);
+
+/*--------------- Engine Functions--------------------*/
+static int EngineAdd(sched_t *sched, task_t *task);
+static size_t EngineAddMany(sched_t *sched, task_t **tasks, size_t count);
+static void EngineErase(sched_t *sched, task_t *task);
+static void EngineUpdate(sched_t *sched, task_t *task);
+static uint64_t EngineNextTime(sched_t *sched);
+static task_t *EnginePopDue(sched_t *sched, uint64_t now);
+static size_t EngineSize(const sched_t *sched);
+static void EngineClear(sched_t *sched);
+static void EngineReset(sched_t *sched);
+static int DestroyTask(void *task, void *sched);
+
+/*--------------- Wait Functions--------------------*/
+static void WaitUntil(sched_t *sched, uint64_t deadline);
+static void WakeUp(sched_t *sched);
+
+/*--------------- Command Functions--------------------*/
+static int IsRunningElsewhere(const sched_t *sched);
+static int SubmitCommand(sched_t *sched, cmd_type_t type, task_t *task, ilrd_uid_t uid, uint64_t ns);
+static void PushCommand(sched_t *sched, sched_cmd_t *cmd);
+static int AskTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats);
+static int WaitAnswer(sched_query_t *query);
+static void ReleaseQuery(sched_query_t *query);
+static int DrainCommands(sched_t *sched);
+static void ClearNow(sched_t *sched);
+static task_t *NewTask(sched_t *sched, const sched_task_desc_t *desc, int is_foreign);
+static int Admit(sched_t *sched, task_t *task);
+static int AdmitMany(sched_t *sched, task_t **tasks, size_t count);
+static int RemoveNow(sched_t *sched, ilrd_uid_t uid);
+static int MoveNow(sched_t *sched, ilrd_uid_t uid, uint64_t time);
+static int SetIntervalNow(sched_t *sched, ilrd_uid_t uid, uint64_t interval_ns);
+static int FinishRun(sched_t *sched, task_t *task, int op_status, int is_removed);
+static int Reschedule(sched_t *sched, task_t *task, int op_status, int is_removed);
+static void DiscardTask(sched_t *sched, task_t *task);
+static void ReleaseTask(sched_t *sched, task_t *task);
+static void SetHolder(task_t *task, int holder, size_t index, void *node);
+
+/*--------------- Stats Functions--------------------*/
+static void RecordRun(sched_t *sched, task_t *task, uint64_t started, uint64_t ended);
+static void Count(atomic_ulong *counter, uint64_t amount);
+static void CountInHistogram(atomic_ulong *histogram, uint64_t value);
+static void ReadHistogram(const atomic_ulong *histogram, sched_histogram_t *out);
+static int ReadTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats);
+
+/*--------------- Batch Functions--------------------*/
+static size_t PopDueBatch(sched_t *sched, uint64_t now);
+static void RunBatch(sched_t *sched);
+static int RequeueBatch(sched_t *sched);
+
+/*--------------- Worker Functions--------------------*/
+static int StartWorkers(sched_t *sched, size_t n_workers);
+static void StopWorkers(sched_t *sched, size_t n_started);
+static int Dispatch(sched_t *sched, task_t *task);
+static void *WorkerRoutine(void *worker);
+static sched_cmd_t *NextJob(sched_worker_t *self);
 
 /*---------------SchedCreate--------------------*/
-sched_t *SchedCreate(void)
+sched_t *SchedCreate(sched_engine_t engine)
 {
-	sched_t *scheduler = (sched_t *)malloc(sizeof(sched_t));
+	sched_t *scheduler = NULL;
+	size_t i = 0;
+	
+	assert(SCHED_QUEUE == engine || SCHED_WHEEL == engine);
+	
+	scheduler = (sched_t *)malloc(sizeof(sched_t));
 	if (NULL == scheduler)
 	{
 		return NULL;
 	}
 	
-	scheduler->pq = PQCreate(&TaskCmp);
-	if (NULL == scheduler->pq)
+	scheduler->engine = engine;
+	scheduler->pq = NULL;
+	scheduler->wheel = NULL;
+	
+	if (SCHED_WHEEL == engine)
+	{
+		scheduler->wheel = TWCreate(&TaskTick, MonoTimeNow() / SCHED_WHEEL_TICK_NS);
+	}
+	else
+	{
+		scheduler->pq = PQCreateTracked(&TaskCmp, PQ_HEAP, &TrackInQueue);
+	}
+	
+	if (NULL == scheduler->pq && NULL == scheduler->wheel)
+	{
+		free(scheduler);
+		scheduler = NULL;
+		
+		return NULL;
+	}
+	
+	scheduler->task_pool = SlabCreate(TaskObjectSize(), TASKS_PER_BLOCK);
+	if (NULL == scheduler->task_pool)
 	{
+		if (SCHED_WHEEL == engine)
+		{
+			TWDestroy(scheduler->wheel);
+		}
+		else
+		{
+			PQDestroy(scheduler->pq);
+		}
 		free(scheduler);
 		scheduler = NULL;
 		
 		return NULL;
 	}
 	
-	scheduler->to_stop = FALSE;
+	atomic_init(&scheduler->to_stop, FALSE);
+	atomic_init(&scheduler->is_running, FALSE);
+	atomic_init(&scheduler->n_tasks, 0);
+	atomic_init(&scheduler->n_unpooled, 0);
+	atomic_init(&scheduler->n_missed, 0);
+	atomic_init(&scheduler->n_coalesced, 0);
+	atomic_init(&scheduler->n_runs, 0);
+	atomic_init(&scheduler->n_wakeups, 0);
+	atomic_init(&scheduler->loop_ns, 0);
+	atomic_init(&scheduler->busy_ns, 0);
+	atomic_init(&scheduler->idle_ns, 0);
+	for (i = 0; i < SCHED_HIST_BUCKETS; ++i)
+	{
+		atomic_init(&scheduler->run_hist[i], 0);
+		atomic_init(&scheduler->lateness_hist[i], 0);
+	}
 	scheduler->current_task = NULL;
 	scheduler->to_remove_current = FALSE;
+	scheduler->batch_size = 0;
+	scheduler->batch_capacity = INITIAL_BATCH_CAPACITY;
+	scheduler->batch = (task_t **)malloc(INITIAL_BATCH_CAPACITY * sizeof(task_t *));
+	scheduler->workers = NULL;
+	scheduler->n_workers = 0;
+	scheduler->in_flight = NULL;
+	
+	scheduler->index = UIDIndexCreate();
+	scheduler->commands = MPSCCreate();
+	scheduler->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	scheduler->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (NULL == scheduler->batch || NULL == scheduler->index || NULL == scheduler->commands ||
+	    -1 == scheduler->wake_fd || -1 == scheduler->timer_fd)
+	{
+		SchedDestroy(scheduler);
+		
+		return NULL;
+	}
 	
 	return scheduler; 
 	
@@ -64,7 +310,34 @@ void SchedDestroy(sched_t *sched)
 	
 	SchedClear(sched);
 	
-	PQDestroy(sched->pq);
+	if (SCHED_WHEEL == sched->engine)
+	{
+		TWDestroy(sched->wheel);
+	}
+	else
+	{
+		PQDestroy(sched->pq);
+	}
+	SlabDestroy(sched->task_pool);
+	
+	if (NULL != sched->index)
+	{
+		UIDIndexDestroy(sched->index);
+	}
+	if (NULL != sched->commands)
+	{
+		MPSCDestroy(sched->commands);
+	}
+	free(sched->batch);
+	sched->batch = NULL;
+	if (-1 != sched->wake_fd)
+	{
+		close(sched->wake_fd);
+	}
+	if (-1 != sched->timer_fd)
+	{
+		close(sched->timer_fd);
+	}
 	free(sched);
 	sched = NULL;
 }
@@ -77,150 +350,458 @@ ilrd_uid_t SchedAdd(sched_t *sched,
 			   void *operation_func_params,
 			   void *clean_func_params,
 			   void (*clean_func)(void *param))
+{
+	return SchedAddNs(sched, (uint64_t)delay * NS_IN_SEC, (uint64_t)interval_in_sec * NS_IN_SEC,
+	                  oper_func, operation_func_params, clean_func_params, clean_func);
+}
+
+/*---------------SchedAddMs--------------------*/
+ilrd_uid_t SchedAddMs(sched_t *sched,
+			   size_t delay_ms,
+			   size_t interval_ms,
+			   int (*oper_func)(void *param),
+			   void *operation_func_params,
+			   void *clean_func_params,
+			   void (*clean_func)(void *param))
+{
+	return SchedAddNs(sched, (uint64_t)delay_ms * NS_IN_MS, (uint64_t)interval_ms * NS_IN_MS,
+	                  oper_func, operation_func_params, clean_func_params, clean_func);
+}
+
+/*---------------SchedAddNs--------------------*/
+ilrd_uid_t SchedAddNs(sched_t *sched,
+			   uint64_t delay_ns,
+			   uint64_t interval_ns,
+			   int (*oper_func)(void *param),
+			   void *operation_func_params,
+			   void *clean_func_params,
+			   void (*clean_func)(void *param))
+{
+	sched_task_desc_t desc = {0};
+	
+	desc.delay_ns = delay_ns;
+	desc.interval_ns = interval_ns;
+	desc.overrun = SCHED_CATCH_UP;
+	desc.oper_func = oper_func;
+	desc.oper_params = operation_func_params;
+	desc.clean_params = clean_func_params;
+	desc.clean_func = clean_func;
+	
+	return SchedAddTask(sched, &desc);
+}
+
+/*---------------SchedAddTask--------------------*/
+ilrd_uid_t SchedAddTask(sched_t *sched, const sched_task_desc_t *desc)
 {
 	task_t *task = NULL;
+	ilrd_uid_t uid = UIDBadUID;
+	int status = SUCCESS;
+	int is_foreign = FALSE;
 	
 	assert(NULL != sched);
-	assert(NULL != oper_func);
-	assert(NULL != clean_func);
+	assert(NULL != desc);
 	
-	task = TaskCreate(delay, interval_in_sec, oper_func, operation_func_params, clean_func_params, clean_func);
+	is_foreign = IsRunningElsewhere(sched);
 	
+	task = NewTask(sched, desc, is_foreign);
 	if (NULL == task)
 	{
 		return UIDBadUID;
 	}
 	
-	if (SUCCESS != PQEnqueue(sched->pq , task))
+	/* once submitted, SchedRun may run and destroy the task at any moment */
+	uid = TaskGetUID(task);
+	
+	if (is_foreign)
+	{
+		status = SubmitCommand(sched, CMD_ADD, task, uid, 0);
+	}
+	else
+	{
+		DrainCommands(sched);
+		status = Admit(sched , task);
+	}
+	
+	if (SUCCESS != status)
 	{
-		TaskDestroy(task);
+		ReleaseTask(sched, task);
 		return UIDBadUID;
 	}
 	
-	return TaskGetUID(task);
+	return uid;
+}
+
+/*---------------SchedAddBatch--------------------*/
+int SchedAddBatch(sched_t *sched, const sched_task_desc_t *descs, size_t count, ilrd_uid_t *uids)
+{
+	task_t **tasks = NULL;
+	size_t created = 0;
+	size_t i = 0;
+	int status = SUCCESS;
+	
+	assert(NULL != sched);
+	assert(NULL != descs || 0 == count);
+	assert(NULL != uids || 0 == count);
+	
+	/* queued one by one, the thread running SchedRun admits them */
+	if (IsRunningElsewhere(sched))
+	{
+		for (i = 0; i < count; ++i)
+		{
+			uids[i] = SchedAddTask(sched, &descs[i]);
+			if (UIDIsSame(uids[i], UIDBadUID))
+			{
+				SchedRemoveBatch(sched, uids, i);
+				status = MEMORY_ERR;
+				break;
+			}
+		}
+	}
+	else
+	{
+		DrainCommands(sched);
+		
+		tasks = (task_t **)malloc(count * sizeof(task_t *));
+		if (NULL == tasks && 0 != count)
+		{
+			status = MEMORY_ERR;
+		}
+		
+		for (created = 0; SUCCESS == status && created < count; ++created)
+		{
+			tasks[created] = NewTask(sched, &descs[created], FALSE);
+			if (NULL == tasks[created])
+			{
+				status = MEMORY_ERR;
+				break;
+			}
+		}
+		
+		if (SUCCESS == status)
+		{
+			status = AdmitMany(sched, tasks, count);
+		}
+		
+		for (i = 0; i < created; ++i)
+		{
+			if (SUCCESS == status)
+			{
+				uids[i] = TaskGetUID(tasks[i]);
+			}
+			else
+			{
+				ReleaseTask(sched, tasks[i]);
+			}
+		}
+		
+		free(tasks);
+	}
+	
+	/* all or nothing */
+	for (i = 0; SUCCESS != status && i < count; ++i)
+	{
+		uids[i] = UIDBadUID;
+	}
+	
+	return status;
 }
 
 /*---------------SchedRemove--------------------*/
 int SchedRemove(sched_t *sched, ilrd_uid_t uid)
 {	
-	task_t *task_to_remove = NULL;
+	assert(NULL != sched);
+	assert(!UIDIsSame(uid , UIDBadUID));
+	
+	if (IsRunningElsewhere(sched))
+	{
+		return SubmitCommand(sched, CMD_REMOVE, NULL, uid, 0);
+	}
+	
+	DrainCommands(sched);
+	
+	return RemoveNow(sched, uid);
+}
+
+/*---------------SchedRemoveBatch--------------------*/
+size_t SchedRemoveBatch(sched_t *sched, const ilrd_uid_t *uids, size_t count)
+{
+	size_t removed = 0;
+	size_t i = 0;
+	int is_foreign = FALSE;
+	
+	assert(NULL != sched);
+	assert(NULL != uids || 0 == count);
+	
+	is_foreign = IsRunningElsewhere(sched);
+	if (!is_foreign)
+	{
+		DrainCommands(sched);
+	}
+	
+	for (i = 0; i < count; ++i)
+	{
+		assert(!UIDIsSame(uids[i] , UIDBadUID));
+		
+		if (is_foreign)
+		{
+			removed += (SUCCESS == SubmitCommand(sched, CMD_REMOVE, NULL, uids[i], 0));
+		}
+		else
+		{
+			removed += (SUCCESS == RemoveNow(sched, uids[i]));
+		}
+	}
+	
+	return removed;
+}
+
+/*---------------SchedReschedule--------------------*/
+int SchedReschedule(sched_t *sched, ilrd_uid_t uid, uint64_t delay_ns)
+{
+	uint64_t time = 0;
 	
 	assert(NULL != sched);
 	assert(!UIDIsSame(uid , UIDBadUID));
 	
-	/* a task is found inside the schedule queue */
-	task_to_remove = PQErase(sched->pq , &IsMatch , &uid);
-	if (NULL != task_to_remove)
+	/* the delay counts from the call, not from when the command is applied */
+	time = MonoTimeNow() + delay_ns;
+	
+	if (IsRunningElsewhere(sched))
 	{
-		TaskDestroy(task_to_remove);
-		return SUCCESS;	
+		return SubmitCommand(sched, CMD_RESCHEDULE, NULL, uid, time);
 	}
 	
-	/* the current task (outside of queue) is the one to be removed */
-	if (NULL != sched->current_task  &&  TaskIsMatch(uid , sched->current_task))
+	DrainCommands(sched);
+	
+	return MoveNow(sched, uid, time);
+}
+
+/*---------------SchedSetInterval--------------------*/
+int SchedSetInterval(sched_t *sched, ilrd_uid_t uid, uint64_t interval_ns)
+{
+	assert(NULL != sched);
+	assert(!UIDIsSame(uid , UIDBadUID));
+	
+	if (IsRunningElsewhere(sched))
 	{
-		sched->to_remove_current = TRUE;
-		return SUCCESS;
+		return SubmitCommand(sched, CMD_SET_INTERVAL, NULL, uid, interval_ns);
 	}
 	
-	/* task not found */	
-	return NOT_FOUND;
+	DrainCommands(sched);
+	
+	return SetIntervalNow(sched, uid, interval_ns);
 }
 
 /*---------------SchedRun--------------------*/
 int SchedRun(sched_t *sched)
 {
-	task_t *task = NULL;
-	time_t timer = 0;
-	int status = 0;
+	int run_status = NO_MORE_TASKS;
+	uint64_t entered = MonoTimeNow();
 	
 	assert(NULL != sched);
 	
-	while (0 == sched->to_stop  && !PQIsEmpty(sched->pq))
+	sched->run_thread = pthread_self();
+	atomic_store_explicit(&sched->is_running, TRUE, memory_order_release);
+	
+	DrainCommands(sched);
+	
+	while (FALSE == atomic_load(&sched->to_stop)  && 0 != EngineSize(sched) && MEMORY_ERR != run_status)
 	{
-		sched->current_task = PQDequeue(sched->pq);
+		/* every task due by now is taken and put back in one go */
+		if (0 == PopDueBatch(sched, MonoTimeNow()))
+		{
+			WaitUntil(sched, EngineNextTime(sched));
+			DrainCommands(sched);
+			continue;
+		}
 		
-		task = sched->current_task;
+		RunBatch(sched);
 		
-		timer = TaskGetTimeToRun(task);
-				
-		while (timer != time(NULL))
+		if (SUCCESS != RequeueBatch(sched))
 		{
-			sleep(1);
+			run_status = MEMORY_ERR;
 		}
 		
-		status = TaskRun(task);
+		DrainCommands(sched);
+	}
+	
+	Count(&sched->loop_ns, MonoTimeNow() - entered);
+	
+	/* commands submitted from now on are drained by the next owner call.
+	   the ones submitted until now are applied, so no query waits for it */
+	atomic_store_explicit(&sched->is_running, FALSE, memory_order_release);
+	DrainCommands(sched);
+	
+	if (MEMORY_ERR == run_status)
+	{
+		return MEMORY_ERR;
+	}
+	
+	if (TRUE == atomic_exchange(&sched->to_stop, FALSE))
+	{
+		return STOPPED;
+	}
 		
-		switch (status)
-		{
-		case OP_DONE:
-		case OP_ERROR:
-				free(task);
-				break;
+	return NO_MORE_TASKS;
+}
+
+
+/*---------------SchedRunParallel--------------------*/
+int SchedRunParallel(sched_t *sched, size_t n_workers)
+{
+	task_t *task = NULL;
+	int run_status = NO_MORE_TASKS;
+	uint64_t entered = MonoTimeNow();
+	
+	assert(NULL != sched);
+	assert(0 < n_workers);
+	
+	sched->in_flight = DListCreate();
+	if (NULL == sched->in_flight)
+	{
+		return MEMORY_ERR;
+	}
+	
+	if (SUCCESS != StartWorkers(sched, n_workers))
+	{
+		DListDestroy(sched->in_flight);
+		sched->in_flight = NULL;
 		
-		case OP_CONTINUE:			
-				TaskUpdateTimeToRun(task);
-				if (1 == sched->to_remove_current)
-				{
-					free(task);
-					sched->to_remove_current = 0;
-					break;
-				}
-				if (SUCCESS != PQEnqueue(sched->pq, task))
-				{
-					free(task);
-					return MEMORY_ERR;
-				}
-				break;	
-		}	
-		sched->current_task = NULL;
+		return MEMORY_ERR;
 	}
+	
+	sched->run_thread = pthread_self();
+	atomic_store_explicit(&sched->is_running, TRUE, memory_order_release);
+	
+	DrainCommands(sched);
+	
+	/* this thread only keeps time, the workers run the tasks */
+	while (FALSE == atomic_load(&sched->to_stop) && MEMORY_ERR != run_status &&
+	       (0 != EngineSize(sched) || !DListIsEmpty(sched->in_flight)))
+	{
+		task = (0 != EngineSize(sched)) ? EnginePopDue(sched, MonoTimeNow()) : NULL;
+		if (NULL == task)
+		{
+			WaitUntil(sched, (0 != EngineSize(sched)) ? EngineNextTime(sched) : WAIT_FOREVER);
+		}
+		else if (SUCCESS != Dispatch(sched, task))
+		{
+			if (SUCCESS != EngineAdd(sched, task))
+			{
+				DiscardTask(sched, task);
+			}
+			run_status = MEMORY_ERR;
+		}
 		
-	if (1 == sched->to_stop)
+		if (SUCCESS != DrainCommands(sched))
+		{
+			run_status = MEMORY_ERR;
+		}
+	}
+	
+	/* waits for the running tasks, the ones not started go back to the engine */
+	StopWorkers(sched, n_workers);
+	if (SUCCESS != DrainCommands(sched))
+	{
+		run_status = MEMORY_ERR;
+	}
+	
+	Count(&sched->loop_ns, MonoTimeNow() - entered);
+	atomic_store_explicit(&sched->is_running, FALSE, memory_order_release);
+	
+	/* no worker is left, the commands until now are applied, so no query waits for it */
+	if (SUCCESS != DrainCommands(sched))
+	{
+		run_status = MEMORY_ERR;
+	}
+	
+	DListDestroy(sched->in_flight);
+	sched->in_flight = NULL;
+	
+	if (MEMORY_ERR == run_status)
+	{
+		return MEMORY_ERR;
+	}
+	
+	if (TRUE == atomic_exchange(&sched->to_stop, FALSE))
 	{
-		sched->to_stop = 0;
 		return STOPPED;
 	}
 		
 	return NO_MORE_TASKS;
 }
 
-
 /*---------------SchedStop--------------------*/
 void SchedStop(sched_t *sched)
 {
 	assert(NULL != sched);
 	
-	sched->to_stop = TRUE;	
+	atomic_store(&sched->to_stop, TRUE);
+	WakeUp(sched);
 }
 
-size_t SchedSize(const sched_t *sched)
+/*---------------SchedGetOverrunStats--------------------*/
+void SchedGetOverrunStats(const sched_t *sched, sched_overrun_stats_t *stats)
 {
 	assert(NULL != sched);
+	assert(NULL != stats);
 	
-	if (NULL == sched->current_task)
-	{
-		return PQGetSize(sched->pq);
-	}
-	return PQGetSize(sched->pq) + 1;
+	stats->missed = atomic_load(&sched->n_missed);
+	stats->coalesced = atomic_load(&sched->n_coalesced);
 }
 
-void SchedClear(sched_t *sched)
+/*---------------SchedGetStats--------------------*/
+void SchedGetStats(const sched_t *sched, sched_stats_t *stats)
 {
-	void *task_to_destroy = NULL;
+	assert(NULL != sched);
+	assert(NULL != stats);
+	
+	stats->runs = atomic_load_explicit(&sched->n_runs, memory_order_relaxed);
+	stats->wakeups = atomic_load_explicit(&sched->n_wakeups, memory_order_relaxed);
+	stats->loop_ns = atomic_load_explicit(&sched->loop_ns, memory_order_relaxed);
+	stats->busy_ns = atomic_load_explicit(&sched->busy_ns, memory_order_relaxed);
+	stats->idle_ns = atomic_load_explicit(&sched->idle_ns, memory_order_relaxed);
+	ReadHistogram(sched->run_hist, &stats->run_ns);
+	ReadHistogram(sched->lateness_hist, &stats->lateness_ns);
+}
 
+/*---------------SchedGetTaskStats--------------------*/
+int SchedGetTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats)
+{
 	assert(NULL != sched);
-		
-	while (!PQIsEmpty(sched->pq))
+	assert(NULL != stats);
+	
+	/* the index and the task belong to the thread running SchedRun */
+	if (IsRunningElsewhere(sched))
 	{
-		task_to_destroy = PQDequeue(sched->pq); 
-		TaskDestroy((task_t *)task_to_destroy);
+		return AskTaskStats(sched, uid, stats);
 	}
 	
-	if (NULL != sched->current_task)
+	return ReadTaskStats(sched, uid, stats);
+}
+
+/*---------------SchedSize--------------------*/
+size_t SchedSize(const sched_t *sched)
+{
+	assert(NULL != sched);
+	
+	return atomic_load(&sched->n_tasks);
+}
+
+/*---------------SchedClear--------------------*/
+void SchedClear(sched_t *sched)
+{
+	assert(NULL != sched);
+	
+	if (IsRunningElsewhere(sched))
 	{
-		sched->to_remove_current = TRUE;
+		/* the tasks belong to the running loop, it clears them between two tasks */
+		SubmitCommand(sched, CMD_CLEAR, NULL, UIDBadUID, 0);
+		return;
 	}
+	
+	DrainCommands(sched);
+	ClearNow(sched);
 }
 
 /*---------------SchedIsEmpty--------------------*/
@@ -228,25 +809,1127 @@ int SchedIsEmpty(const sched_t *sched)
 {
 	assert(NULL != sched);
 	
-	return ((PQIsEmpty(sched->pq)) && (NULL == sched->current_task));
+	return (0 == atomic_load(&sched->n_tasks));
 }
 
 
 /*--------------- Compare Function--------------------*/
 static int TaskCmp(const void *task1, const void *task2)
 {
+	uint64_t time1 = 0;
+	uint64_t time2 = 0;
+	
 	assert(NULL != task1);
 	assert(NULL != task2);
 	
-	return TaskGetTimeToRun((task_t*)task1) - TaskGetTimeToRun((task_t*)task2);
+	time1 = TaskGetTimeToRun((task_t*)task1);
+	time2 = TaskGetTimeToRun((task_t*)task2);
+	
+	/* the earlier task is dequeued first */
+	return (time1 < time2) - (time1 > time2);
 }
 
-/*--------------- Match Function--------------------*/
-static int IsMatch(const void *task, const void *uid)
+/*--------------- Track Function--------------------*/
+static void TrackInQueue(void *task, pq_handle_t handle)
 {
 	assert(NULL != task);
-	assert(NULL != uid);
 	
-	return TaskIsMatch(*(ilrd_uid_t *)uid , (const task_t *)task);
+	SetHolder((task_t *)task, HELD_BY_ENGINE, handle.index, handle.node);
+}
+
+/*--------------- Wheel Tick Function--------------------*/
+static tw_tick_t TaskTick(const void *task)
+{
+	assert(NULL != task);
+	
+	/* round up, a task never expires before its time */
+	return (TaskGetTimeToRun((const task_t *)task) + SCHED_WHEEL_TICK_NS - 1) / SCHED_WHEEL_TICK_NS;
+}
+
+/*--------------- Engine Functions--------------------*/
+
+/* This function adds a task to the engine */
+static int EngineAdd(sched_t *sched, task_t *task)
+{
+	tw_handle_t node = NULL;
+	
+	if (SCHED_WHEEL == sched->engine)
+	{
+		node = TWAdd(sched->wheel, task);
+		if (NULL == node)
+		{
+			return MEMORY_ERR;
+		}
+		
+		SetHolder(task, HELD_BY_ENGINE, 0, node);
+		return SUCCESS;
+	}
+	
+	/* the queue reports where the task is through TrackInQueue */
+	return PQEnqueue(sched->pq, task);
+}
+
+/* This function adds count tasks, returns how many from the start of tasks were added */
+static size_t EngineAddMany(sched_t *sched, task_t **tasks, size_t count)
+{
+	size_t i = 0;
+	
+	if (SCHED_WHEEL == sched->engine)
+	{
+		for (i = 0; i < count && SUCCESS == EngineAdd(sched, tasks[i]); ++i)
+		{
+		}
+		
+		return i;
+	}
+	
+	return PQEnqueueMany(sched->pq, (void **)tasks, count);
+}
+
+/* This function removes a task held by the engine, by its handle */
+static void EngineErase(sched_t *sched, task_t *task)
+{
+	task_handle_t handle = TaskGetHandle(task);
+	pq_handle_t in_queue = {0};
+	
+	assert(HELD_BY_ENGINE == handle.holder);
+	
+	if (SCHED_WHEEL == sched->engine)
+	{
+		TWRemove(sched->wheel, (tw_handle_t)handle.node);
+		return;
+	}
+	
+	in_queue.index = handle.index;
+	in_queue.node = handle.node;
+	PQEraseAt(sched->pq, in_queue);
+}
+
+/* This function moves a task held by the engine to its place after its time changed */
+static void EngineUpdate(sched_t *sched, task_t *task)
+{
+	task_handle_t handle = TaskGetHandle(task);
+	pq_handle_t in_queue = {0};
+	
+	assert(HELD_BY_ENGINE == handle.holder);
+	
+	/* neither engine allocates, the task keeps its node */
+	if (SCHED_WHEEL == sched->engine)
+	{
+		TWUpdate(sched->wheel, (tw_handle_t)handle.node);
+		return;
+	}
+	
+	in_queue.index = handle.index;
+	in_queue.node = handle.node;
+	PQUpdateAt(sched->pq, in_queue);
+}
+
+/* This function returns the earliest time a task may be due. must not be empty */
+static uint64_t EngineNextTime(sched_t *sched)
+{
+	if (SCHED_WHEEL == sched->engine)
+	{
+		return TWNextExpiry(sched->wheel) * SCHED_WHEEL_TICK_NS;
+	}
+	
+	return TaskGetTimeToRun(PQPeek(sched->pq));
+}
+
+/* This function removes a task that is due by now, NULL if there is none */
+static task_t *EnginePopDue(sched_t *sched, uint64_t now)
+{
+	if (SCHED_WHEEL == sched->engine)
+	{
+		return TWPopExpired(sched->wheel, now / SCHED_WHEEL_TICK_NS);
+	}
+	
+	if (TaskGetTimeToRun(PQPeek(sched->pq)) > now)
+	{
+		return NULL;
+	}
+	
+	return PQDequeue(sched->pq);
+}
+
+/* This function returns the number of tasks in the engine */
+static size_t EngineSize(const sched_t *sched)
+{
+	if (SCHED_WHEEL == sched->engine)
+	{
+		return TWSize(sched->wheel);
+	}
+	
+	return PQGetSize(sched->pq);
+}
+
+/* This function destroys all the tasks in the engine */
+static void EngineClear(sched_t *sched)
+{
+	if (SCHED_WHEEL == sched->engine)
+	{
+		TWForEach(sched->wheel, &DestroyTask, sched);
+		TWClear(sched->wheel);
+		return;
+	}
+	
+	while (!PQIsEmpty(sched->pq))
+	{
+		DiscardTask(sched, (task_t *)PQDequeue(sched->pq));
+	}
+}
+
+/* This function forgets all the tasks in the engine without destroying them */
+static void EngineReset(sched_t *sched)
+{
+	if (SCHED_WHEEL == sched->engine)
+	{
+		TWClear(sched->wheel);
+		return;
+	}
+	
+	PQClear(sched->pq);
+}
+
+/* This function is an action function that destroys a task */
+static int DestroyTask(void *task, void *sched)
+{
+	DiscardTask((sched_t *)sched, (task_t *)task);
+	
+	return SUCCESS;
+}
+
+
+/*--------------- Wait Functions--------------------*/
+
+/* This function blocks until deadline passes or WakeUp is called */
+static void WaitUntil(sched_t *sched, uint64_t deadline)
+{
+	struct itimerspec timer = {{0}};
+	struct pollfd fds[2] = {{0}};
+	uint64_t drain = 0;
+	uint64_t waited_from = 0;
+	
+	/* an all zero it_value disarms the timer instead of firing it */
+	if (WAIT_FOREVER != deadline)
+	{
+		timer.it_value.tv_sec = (time_t)(deadline / NS_IN_SEC);
+		timer.it_value.tv_nsec = (long)(deadline % NS_IN_SEC) + (0 == deadline);
+	}
+	timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &timer, NULL);
+	
+	fds[0].fd = sched->timer_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = sched->wake_fd;
+	fds[1].events = POLLIN;
+	
+	if (FALSE == atomic_load(&sched->to_stop))
+	{
+		/* EINTR just returns to SchedRun, which recomputes the deadline */
+		waited_from = MonoTimeNow();
+		poll(fds, 2, -1);
+		Count(&sched->idle_ns, MonoTimeNow() - waited_from);
+		Count(&sched->n_wakeups, 1);
+	}
+	
+	/* both descriptors are non blocking, reading resets them */
+	read(sched->wake_fd, &drain, sizeof(drain));
+	read(sched->timer_fd, &drain, sizeof(drain));
+}
+
+/* This function interrupts a waiting SchedRun. async signal safe */
+static void WakeUp(sched_t *sched)
+{
+	uint64_t one = 1;
+	
+	write(sched->wake_fd, &one, sizeof(one));
+}
+
+/*--------------- Command Functions--------------------*/
+
+/* This function checks if another thread is inside SchedRun. the acquire
+   pairs with the release in SchedRun, so run_thread is the one set before */
+static int IsRunningElsewhere(const sched_t *sched)
+{
+	return (TRUE == atomic_load_explicit(&sched->is_running, memory_order_acquire) &&
+	        !pthread_equal(sched->run_thread, pthread_self()));
+}
+
+/* This function hands a change over to the thread running SchedRun */
+static int SubmitCommand(sched_t *sched, cmd_type_t type, task_t *task, ilrd_uid_t uid, uint64_t ns)
+{
+	sched_cmd_t *cmd = NULL;
+	
+	cmd = (sched_cmd_t *)malloc(sizeof(sched_cmd_t));
+	if (NULL == cmd)
+	{
+		return MEMORY_ERR;
+	}
+	
+	cmd->type = type;
+	cmd->task = task;
+	cmd->uid = uid;
+	cmd->ns = ns;
+	cmd->query = NULL;
+	
+	PushCommand(sched, cmd);
+	
+	return SUCCESS;
+}
+
+/* This function queues cmd for the thread running SchedRun */
+static void PushCommand(sched_t *sched, sched_cmd_t *cmd)
+{
+	int was_empty = FALSE;
+	
+	MPSCPush(sched->commands, &cmd->node, &was_empty);
+	
+	/* one wakeup per batch, SchedRun drains everything once awake */
+	if (was_empty)
+	{
+		WakeUp(sched);
+	}
+}
+
+/* This function has the thread running SchedRun read the stats, and waits for them */
+static int AskTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats)
+{
+	sched_query_t *query = NULL;
+	sched_cmd_t *cmd = NULL;
+	int status = NOT_FOUND;
+	int was_running = TRUE;
+	
+	query = (sched_query_t *)malloc(sizeof(sched_query_t));
+	cmd = (sched_cmd_t *)malloc(sizeof(sched_cmd_t));
+	if (NULL == query || NULL == cmd)
+	{
+		free(query);
+		free(cmd);
+		return MEMORY_ERR;
+	}
+	
+	query->status = NOT_FOUND;
+	sem_init(&query->answered, 0, 0);
+	atomic_init(&query->refs, 2);
+	
+	cmd->type = CMD_GET_STATS;
+	cmd->task = NULL;
+	cmd->uid = uid;
+	cmd->ns = 0;
+	cmd->query = query;
+	
+	PushCommand(sched, cmd);
+	
+	/* SchedRun answers once more after it clears is_running. a query pushed
+	   after that waits for the next owner call - not answered a poll after
+	   SchedRun was seen stopped, it is given up */
+	while (!WaitAnswer(query))
+	{
+		if (!was_running)
+		{
+			ReleaseQuery(query);
+			return NOT_FOUND;
+		}
+		was_running = (TRUE == atomic_load_explicit(&sched->is_running, memory_order_acquire));
+	}
+	
+	status = query->status;
+	if (SUCCESS == status)
+	{
+		*stats = query->stats;
+	}
+	ReleaseQuery(query);
+	
+	return status;
+}
+
+/* This function waits QUERY_POLL_NS at most for the answer to query */
+static int WaitAnswer(sched_query_t *query)
+{
+	struct timespec deadline = {0};
+	
+	/* sem_timedwait counts on the realtime clock */
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_nsec += QUERY_POLL_NS;
+	if ((long)NS_IN_SEC <= deadline.tv_nsec)
+	{
+		deadline.tv_nsec -= NS_IN_SEC;
+		++deadline.tv_sec;
+	}
+	
+	while (0 != sem_timedwait(&query->answered, &deadline))
+	{
+		if (EINTR != errno)
+		{
+			return FALSE;
+		}
+	}
+	
+	return TRUE;
+}
+
+/* This function lets go of query, freeing it if the other side already did */
+static void ReleaseQuery(sched_query_t *query)
+{
+	if (1 == atomic_fetch_sub(&query->refs, 1))
+	{
+		sem_destroy(&query->answered);
+		free(query);
+	}
+}
+
+/* This function applies the submitted changes. owner thread only */
+static int DrainCommands(sched_t *sched)
+{
+	sched_cmd_t *cmd = NULL;
+	int status = SUCCESS;
+	
+	if (NULL == sched->commands)
+	{
+		/* SchedCreate failed half way */
+		return SUCCESS;
+	}
+	
+	while (NULL != (cmd = (sched_cmd_t *)MPSCPop(sched->commands)))
+	{
+		switch (cmd->type)
+		{
+		case CMD_ADD:
+				if (SUCCESS != Admit(sched, cmd->task))
+				{
+					ReleaseTask(sched, cmd->task);
+				}
+				break;
+		
+		case CMD_REMOVE:
+				RemoveNow(sched, cmd->uid);
+				break;
+		
+		case CMD_RESCHEDULE:
+				MoveNow(sched, cmd->uid, cmd->ns);
+				break;
+		
+		case CMD_SET_INTERVAL:
+				SetIntervalNow(sched, cmd->uid, cmd->ns);
+				break;
+		
+		case CMD_GET_STATS:
+				cmd->query->status = ReadTaskStats(sched, cmd->uid, &cmd->query->stats);
+				sem_post(&cmd->query->answered);
+				ReleaseQuery(cmd->query);
+				break;
+		
+		case CMD_CLEAR:
+				ClearNow(sched);
+				break;
+		
+		case CMD_DONE:
+				DListRemove(cmd->where);
+				if (0 != cmd->started)
+				{
+					RecordRun(sched, cmd->task, cmd->started, cmd->ended);
+				}
+				if (SUCCESS != FinishRun(sched, cmd->task, cmd->status, atomic_load(&cmd->cancelled)))
+				{
+					status = MEMORY_ERR;
+				}
+				break;
+		}
+		
+		free(cmd);
+	}
+	
+	return status;
+}
+
+/* This function drops every task. owner thread only, a task of the running
+   batch is dropped once it ends */
+static void ClearNow(sched_t *sched)
+{
+	size_t cleared = 0;
+	size_t i = 0;
+	
+	/* every task is in the engine and in the pool - drop them all at once */
+	if (0 == sched->batch_size && NULL == sched->in_flight && 0 == atomic_load(&sched->n_unpooled))
+	{
+		cleared = EngineSize(sched);
+		EngineReset(sched);
+		if (NULL != sched->index)
+		{
+			/* NULL if SchedCreate failed half way */
+			UIDIndexClear(sched->index);
+		}
+		SlabReset(sched->task_pool);
+		atomic_fetch_sub(&sched->n_tasks, cleared);
+		
+		return;
+	}
+	
+	EngineClear(sched);
+	
+	/* called by a task, the rest of its batch goes too */
+	for (i = 0; i < sched->batch_size; ++i)
+	{
+		if (NULL == sched->batch[i])
+		{
+			/* gone already. current_task is NULL too between two tasks */
+			continue;
+		}
+		
+		if (sched->current_task == sched->batch[i])
+		{
+			sched->to_remove_current = TRUE;
+		}
+		else
+		{
+			DiscardTask(sched, sched->batch[i]);
+			sched->batch[i] = NULL;
+		}
+	}
+}
+
+/* This function creates a task and counts it, NULL on failure */
+static task_t *NewTask(sched_t *sched, const sched_task_desc_t *desc, int is_foreign)
+{
+	task_t *task = NULL;
+	
+	assert(NULL != desc->oper_func);
+	assert(NULL != desc->clean_func);
+	
+	/* 
+	*  the pool belongs to the owning thread, the others use malloc. 
+	*  sched_overrun_t and task_overrun_t list the policies in the same order 
+	*/
+	task = TaskCreate(desc->delay_ns, desc->interval_ns, (task_overrun_t)desc->overrun,
+	                  desc->oper_func, desc->oper_params, desc->clean_params, desc->clean_func,
+	                  (is_foreign) ? (NULL) : (sched->task_pool));
+	if (NULL == task)
+	{
+		return NULL;
+	}
+	
+	atomic_fetch_add(&sched->n_tasks, 1);
+	if (is_foreign)
+	{
+		atomic_fetch_add(&sched->n_unpooled, 1);
+	}
+	
+	return task;
+}
+
+/* This function indexes a new task and queues it. owner thread only */
+static int Admit(sched_t *sched, task_t *task)
+{
+	if (SUCCESS != UIDIndexInsert(sched->index, TaskGetUID(task), task))
+	{
+		return MEMORY_ERR;
+	}
+	
+	if (SUCCESS != EngineAdd(sched, task))
+	{
+		UIDIndexRemove(sched->index, TaskGetUID(task));
+		return MEMORY_ERR;
+	}
+	
+	return SUCCESS;
+}
+
+/* This function indexes count new tasks and queues them in one go, all or none. owner thread only */
+static int AdmitMany(sched_t *sched, task_t **tasks, size_t count)
+{
+	size_t indexed = 0;
+	size_t added = 0;
+	size_t i = 0;
+	
+	/* one growth for the whole batch instead of one per doubling */
+	if (SUCCESS != UIDIndexReserve(sched->index, count))
+	{
+		return MEMORY_ERR;
+	}
+	
+	for (indexed = 0; indexed < count; ++indexed)
+	{
+		if (SUCCESS != UIDIndexInsert(sched->index, TaskGetUID(tasks[indexed]), tasks[indexed]))
+		{
+			break;
+		}
+	}
+	
+	/* the queue heapifies a large batch instead of sifting each task */
+	if (indexed == count)
+	{
+		added = EngineAddMany(sched, tasks, count);
+	}
+	
+	if (added == count)
+	{
+		return SUCCESS;
+	}
+	
+	for (i = 0; i < added; ++i)
+	{
+		EngineErase(sched, tasks[i]);
+	}
+	for (i = 0; i < indexed; ++i)
+	{
+		UIDIndexRemove(sched->index, TaskGetUID(tasks[i]));
+	}
+	
+	return MEMORY_ERR;
+}
+
+/* This function removes the task with uid. owner thread only */
+static int RemoveNow(sched_t *sched, ilrd_uid_t uid)
+{
+	task_t *task = NULL;
+	task_handle_t handle = {0};
+	
+	task = (task_t *)UIDIndexFind(sched->index, uid);
+	if (NULL == task)
+	{
+		/* task not found */
+		return NOT_FOUND;
+	}
+	
+	handle = TaskGetHandle(task);
+	switch (handle.holder)
+	{
+	case HELD_BY_ENGINE:
+			EngineErase(sched, task);
+			DiscardTask(sched, task);
+			break;
+	
+	case HELD_BY_BATCH:
+			/* a task of the batch SchedRun is running, outside of queue */
+			if (sched->current_task == task)
+			{
+				sched->to_remove_current = TRUE;
+			}
+			else
+			{
+				sched->batch[handle.index] = NULL;
+				DiscardTask(sched, task);
+			}
+			break;
+	
+	case HELD_BY_WORKER:
+			/* a task handed to a worker, it is destroyed once it comes back */
+			atomic_store(&((sched_cmd_t *)handle.node)->cancelled, TRUE);
+			break;
+	}
+	
+	return SUCCESS;
+}
+
+/* This function sets the next run of the task with uid to time. owner thread only */
+static int MoveNow(sched_t *sched, ilrd_uid_t uid, uint64_t time)
+{
+	task_t *task = NULL;
+	task_handle_t handle = {0};
+	uint64_t old_time = 0;
+	
+	task = (task_t *)UIDIndexFind(sched->index, uid);
+	if (NULL == task)
+	{
+		return NOT_FOUND;
+	}
+	
+	handle = TaskGetHandle(task);
+	switch (handle.holder)
+	{
+	case HELD_BY_ENGINE:
+			TaskSetTimeToRun(task, time);
+			EngineUpdate(sched, task);
+			break;
+	
+	case HELD_BY_BATCH:
+			/* the running task takes the new time once its run ends */
+			if (sched->current_task == task)
+			{
+				TaskSetNextTimeToRun(task, time);
+				break;
+			}
+			
+			/* a task of the batch does not run before its new time */
+			old_time = TaskGetTimeToRun(task);
+			TaskSetTimeToRun(task, time);
+			if (SUCCESS != EngineAdd(sched, task))
+			{
+				TaskSetTimeToRun(task, old_time);
+				return MEMORY_ERR;
+			}
+			sched->batch[handle.index] = NULL;
+			break;
+	
+	case HELD_BY_WORKER:
+			/* a task handed to a worker, it is skipped if it did not start yet */
+			TaskSetNextTimeToRun(task, time);
+			atomic_store(&((sched_cmd_t *)handle.node)->deferred, TRUE);
+			break;
+	}
+	
+	return SUCCESS;
+}
+
+/* This function sets the interval of the task with uid. owner thread only */
+static int SetIntervalNow(sched_t *sched, ilrd_uid_t uid, uint64_t interval_ns)
+{
+	task_t *task = NULL;
+	
+	task = (task_t *)UIDIndexFind(sched->index, uid);
+	if (NULL == task)
+	{
+		return NOT_FOUND;
+	}
+	
+	/* the engines order tasks by their next time, which stays as it is */
+	TaskSetInterval(task, interval_ns);
+	
+	return SUCCESS;
+}
+
+/* This function puts a task that ran back in the engine, or destroys it */
+static int FinishRun(sched_t *sched, task_t *task, int op_status, int is_removed)
+{
+	if (TRUE == Reschedule(sched, task, op_status, is_removed) && SUCCESS != EngineAdd(sched, task))
+	{
+		DiscardTask(sched, task);
+		return MEMORY_ERR;
+	}
+	
+	return SUCCESS;
+}
+
+/* This function sets the next run of a task that ran. FALSE if it was destroyed instead */
+static int Reschedule(sched_t *sched, task_t *task, int op_status, int is_removed)
+{
+	size_t missed = 0;
+	
+	if (OP_CONTINUE != op_status || TRUE == is_removed)
+	{
+		DiscardTask(sched, task);
+		return FALSE;
+	}
+	
+	missed = TaskUpdateTimeToRun(task, MonoTimeNow());
+	if (0 != missed)
+	{
+		atomic_fetch_add(&sched->n_missed, missed);
+		if (TASK_CATCH_UP != TaskGetOverrun(task))
+		{
+			atomic_fetch_add(&sched->n_coalesced, missed);
+		}
+	}
+	
+	return TRUE;
+}
+
+/* This function destroys a task that left the scheduler. owner thread only */
+static void DiscardTask(sched_t *sched, task_t *task)
+{
+	UIDIndexRemove(sched->index, TaskGetUID(task));
+	ReleaseTask(sched, task);
+}
+
+/* This function destroys a task that was never indexed */
+static void ReleaseTask(sched_t *sched, task_t *task)
+{
+	if (!TaskIsPooled(task))
+	{
+		atomic_fetch_sub(&sched->n_unpooled, 1);
+	}
+	TaskDestroy(task);
+	atomic_fetch_sub(&sched->n_tasks, 1);
+}
+
+/* This function records where a task of the scheduler is */
+static void SetHolder(task_t *task, int holder, size_t index, void *node)
+{
+	task_handle_t handle = {0};
+	
+	handle.holder = holder;
+	handle.index = index;
+	handle.node = node;
+	TaskSetHandle(task, handle);
+}
+
+/*--------------- Stats Functions--------------------*/
+
+/* This function counts a run of task in its stats and in the scheduler's. owner thread only */
+static void RecordRun(sched_t *sched, task_t *task, uint64_t started, uint64_t ended)
+{
+	uint64_t deadline = TaskGetTimeToRun(task);
+	uint64_t lateness = (started > deadline) ? (started - deadline) : (0);
+	
+	TaskRecordRun(task, lateness, ended - started);
+	
+	Count(&sched->n_runs, 1);
+	Count(&sched->busy_ns, ended - started);
+	CountInHistogram(sched->run_hist, ended - started);
+	CountInHistogram(sched->lateness_hist, lateness);
+}
+
+/* This function adds to a counter only the owner thread writes, without a locked instruction */
+static void Count(atomic_ulong *counter, uint64_t amount)
+{
+	atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + amount,
+	                      memory_order_relaxed);
+}
+
+/* This function counts value in the log2 bucket it falls in */
+static void CountInHistogram(atomic_ulong *histogram, uint64_t value)
+{
+	size_t bucket = 0;
+	
+	if (1 < value)
+	{
+		bucket = (size_t)(sizeof(unsigned long) * CHAR_BIT - 1 - __builtin_clzl((unsigned long)value));
+	}
+	if (bucket >= SCHED_HIST_BUCKETS)
+	{
+		bucket = SCHED_HIST_BUCKETS - 1;
+	}
+	
+	Count(&histogram[bucket], 1);
+}
+
+/* This function copies a histogram */
+static void ReadHistogram(const atomic_ulong *histogram, sched_histogram_t *out)
+{
+	size_t i = 0;
+	
+	for (i = 0; i < SCHED_HIST_BUCKETS; ++i)
+	{
+		out->buckets[i] = atomic_load_explicit(&histogram[i], memory_order_relaxed);
+	}
+}
+
+/* This function copies the stats of a task. owner thread only */
+static int ReadTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats)
+{
+	task_t *task = NULL;
+	task_stats_t task_stats = {0};
+	
+	task = (task_t *)UIDIndexFind(sched->index, uid);
+	if (NULL == task)
+	{
+		return NOT_FOUND;
+	}
+	
+	task_stats = TaskGetStats(task);
+	stats->runs = task_stats.runs;
+	stats->total_run_ns = task_stats.total_run_ns;
+	stats->max_run_ns = task_stats.max_run_ns;
+	stats->total_lateness_ns = task_stats.total_lateness_ns;
+	stats->max_lateness_ns = task_stats.max_lateness_ns;
+	
+	return SUCCESS;
+}
+
+/*--------------- Batch Functions--------------------*/
+
+/* This function moves every task due by now from the engine to the batch */
+static size_t PopDueBatch(sched_t *sched, uint64_t now)
+{
+	task_t **batch = NULL;
+	task_t *task = NULL;
+	
+	sched->batch_size = 0;
+	
+	while (0 != EngineSize(sched))
+	{
+		/* the capacity is never below one, a failed growth runs a smaller batch */
+		if (sched->batch_size == sched->batch_capacity)
+		{
+			batch = (task_t **)realloc(sched->batch, 2 * sched->batch_capacity * sizeof(task_t *));
+			if (NULL == batch)
+			{
+				break;
+			}
+			sched->batch = batch;
+			sched->batch_capacity *= 2;
+		}
+		
+		task = EnginePopDue(sched, now);
+		if (NULL == task)
+		{
+			break;
+		}
+		
+		SetHolder(task, HELD_BY_BATCH, sched->batch_size, NULL);
+		sched->batch[sched->batch_size] = task;
+		++sched->batch_size;
+	}
+	
+	return sched->batch_size;
+}
+
+/* This function runs the batch in deadline order, a stop leaves the rest unrun */
+static void RunBatch(sched_t *sched)
+{
+	task_t *task = NULL;
+	int status = 0;
+	uint64_t started = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < sched->batch_size && FALSE == atomic_load(&sched->to_stop); ++i)
+	{
+		/* what other threads asked for so far holds before the next task runs */
+		DrainCommands(sched);
+		
+		task = sched->batch[i];
+		if (NULL == task)
+		{
+			/* removed by an earlier task of the batch, or by another thread */
+			continue;
+		}
+		
+		sched->current_task = task;
+		
+		started = MonoTimeNow();
+		status = TaskRun(task);
+		RecordRun(sched, task, started, MonoTimeNow());
+		
+		if (FALSE == Reschedule(sched, task, status, sched->to_remove_current))
+		{
+			sched->batch[i] = NULL;
+		}
+		sched->current_task = NULL;
+		sched->to_remove_current = FALSE;
+	}
+}
+
+/* This function puts the tasks left in the batch back in the engine at once */
+static int RequeueBatch(sched_t *sched)
+{
+	size_t count = 0;
+	size_t added = 0;
+	size_t i = 0;
+	
+	for (i = 0; i < sched->batch_size; ++i)
+	{
+		if (NULL != sched->batch[i])
+		{
+			sched->batch[count] = sched->batch[i];
+			++count;
+		}
+	}
+	
+	added = EngineAddMany(sched, sched->batch, count);
+	
+	for (i = added; i < count; ++i)
+	{
+		DiscardTask(sched, sched->batch[i]);
+	}
+	
+	sched->batch_size = 0;
+	
+	return (added == count) ? (SUCCESS) : (MEMORY_ERR);
+}
+
+/*--------------- Worker Functions--------------------*/
+
+/* This function creates the deques and the threads of SchedRunParallel */
+static int StartWorkers(sched_t *sched, size_t n_workers)
+{
+	size_t i = 0;
+	
+	sched->workers = (sched_worker_t *)calloc(n_workers, sizeof(sched_worker_t));
+	if (NULL == sched->workers)
+	{
+		return MEMORY_ERR;
+	}
+	
+	sched->n_workers = n_workers;
+	sched->next_worker = 0;
+	atomic_store(&sched->n_queued, 0);
+	atomic_store(&sched->n_idle, 0);
+	atomic_store(&sched->workers_stop, FALSE);
+	pthread_mutex_init(&sched->idle_lock, NULL);
+	pthread_cond_init(&sched->idle_cond, NULL);
+	
+	/* every deque exists before any worker may steal from it */
+	for (i = 0; i < n_workers; ++i)
+	{
+		sched->workers[i].sched = sched;
+		sched->workers[i].id = i;
+		sched->workers[i].jobs = WorkDequeCreate();
+		if (NULL == sched->workers[i].jobs)
+		{
+			StopWorkers(sched, 0);
+			return MEMORY_ERR;
+		}
+	}
+	
+	for (i = 0; i < n_workers; ++i)
+	{
+		if (0 != pthread_create(&sched->workers[i].thread, NULL, &WorkerRoutine, &sched->workers[i]))
+		{
+			StopWorkers(sched, i);
+			return MEMORY_ERR;
+		}
+	}
+	
+	return SUCCESS;
+}
+
+/* This function joins the workers and returns the jobs they did not start */
+static void StopWorkers(sched_t *sched, size_t n_started)
+{
+	sched_cmd_t *job = NULL;
+	size_t i = 0;
+	
+	pthread_mutex_lock(&sched->idle_lock);
+	atomic_store(&sched->workers_stop, TRUE);
+	pthread_cond_broadcast(&sched->idle_cond);
+	pthread_mutex_unlock(&sched->idle_lock);
+	
+	for (i = 0; i < n_started; ++i)
+	{
+		pthread_join(sched->workers[i].thread, NULL);
+	}
+	
+	for (i = 0; i < sched->n_workers && NULL != sched->workers[i].jobs; ++i)
+	{
+		while (NULL != (job = (sched_cmd_t *)WorkDequePop(sched->workers[i].jobs)))
+		{
+			DListRemove(job->where);
+			if (atomic_load(&job->deferred))
+			{
+				/* takes the time set by SchedReschedule */
+				TaskUpdateTimeToRun(job->task, MonoTimeNow());
+			}
+			if (atomic_load(&job->cancelled) || SUCCESS != EngineAdd(sched, job->task))
+			{
+				DiscardTask(sched, job->task);
+			}
+			free(job);
+		}
+		WorkDequeDestroy(sched->workers[i].jobs);
+	}
+	
+	pthread_cond_destroy(&sched->idle_cond);
+	pthread_mutex_destroy(&sched->idle_lock);
+	free(sched->workers);
+	sched->workers = NULL;
+	sched->n_workers = 0;
+}
+
+/* This function hands a due task to the next worker */
+static int Dispatch(sched_t *sched, task_t *task)
+{
+	sched_cmd_t *job = NULL;
+	sched_worker_t *worker = NULL;
+	
+	job = (sched_cmd_t *)malloc(sizeof(sched_cmd_t));
+	if (NULL == job)
+	{
+		return MEMORY_ERR;
+	}
+	
+	job->type = CMD_DONE;
+	job->task = task;
+	job->status = OP_DONE;
+	job->started = 0;
+	job->ended = 0;
+	atomic_init(&job->cancelled, FALSE);
+	atomic_init(&job->deferred, FALSE);
+	
+	job->where = DListPushEnd(sched->in_flight, job);
+	if (DListIsEqual(job->where, DListGetEnd(sched->in_flight)))
+	{
+		free(job);
+		return MEMORY_ERR;
+	}
+	
+	SetHolder(task, HELD_BY_WORKER, 0, job);
+	
+	worker = &sched->workers[sched->next_worker];
+	sched->next_worker = (sched->next_worker + 1) % sched->n_workers;
+	
+	/* counted first, so a worker never sleeps while a job is queued */
+	atomic_fetch_add(&sched->n_queued, 1);
+	if (SUCCESS != WorkDequePush(worker->jobs, job))
+	{
+		atomic_fetch_sub(&sched->n_queued, 1);
+		DListRemove(job->where);
+		free(job);
+		return MEMORY_ERR;
+	}
+	
+	if (0 != atomic_load(&sched->n_idle))
+	{
+		pthread_mutex_lock(&sched->idle_lock);
+		pthread_cond_signal(&sched->idle_cond);
+		pthread_mutex_unlock(&sched->idle_lock);
+	}
+	
+	return SUCCESS;
+}
+
+/* This function runs jobs and sends them back to the timer thread */
+static void *WorkerRoutine(void *worker)
+{
+	sched_worker_t *self = (sched_worker_t *)worker;
+	sched_t *sched = self->sched;
+	sched_cmd_t *job = NULL;
+	int was_empty = FALSE;
+	
+	while (NULL != (job = NextJob(self)))
+	{
+		/* a task removed or rescheduled while it waited in a deque does not run now */
+		if (FALSE == atomic_load(&job->cancelled) && FALSE == atomic_load(&job->deferred))
+		{
+			job->started = MonoTimeNow();
+			job->status = TaskRun(job->task);
+			job->ended = MonoTimeNow();
+		}
+		else
+		{
+			job->status = OP_CONTINUE;
+		}
+		
+		MPSCPush(sched->commands, &job->node, &was_empty);
+		if (was_empty)
+		{
+			WakeUp(sched);
+		}
+	}
+	
+	return NULL;
+}
+
+/* This function takes a job from the own deque, or steals one. NULL on stop */
+static sched_cmd_t *NextJob(sched_worker_t *self)
+{
+	sched_t *sched = self->sched;
+	sched_cmd_t *job = NULL;
+	size_t i = 0;
+	
+	while (FALSE == atomic_load(&sched->workers_stop))
+	{
+		job = (sched_cmd_t *)WorkDequePop(self->jobs);
+		for (i = 1; NULL == job && i < sched->n_workers; ++i)
+		{
+			job = (sched_cmd_t *)WorkDequeSteal(sched->workers[(self->id + i) % sched->n_workers].jobs);
+		}
+		
+		if (NULL != job)
+		{
+			atomic_fetch_sub(&sched->n_queued, 1);
+			return job;
+		}
+		
+		pthread_mutex_lock(&sched->idle_lock);
+		atomic_fetch_add(&sched->n_idle, 1);
+		while (0 == atomic_load(&sched->n_queued) && FALSE == atomic_load(&sched->workers_stop))
+		{
+			pthread_cond_wait(&sched->idle_cond, &sched->idle_lock);
+		}
+		atomic_fetch_sub(&sched->n_idle, 1);
+		pthread_mutex_unlock(&sched->idle_lock);
+	}
+	
+	return NULL;
 }
 
@@ -11,7 +11,7 @@ File          : scheduler.h
 
 
 #include <stddef.h>
-#include <time.h>
+#include <stdint.h>
 #include "uid.h"
 
 typedef enum operation_status 
@@ -28,16 +28,107 @@ typedef enum sched_status
     FUNC_ERR, /* Returned by SchedRun when a task's operation failed */
     STOPPED, /* Returned by SchedRun when stopped explicitly */
     NO_MORE_TASKS, /* Returned by SchedRun when there are no more tasks to preform */
-    NOT_FOUND /* Returned by SchedRemove when task was not found */
+    NOT_FOUND /* Returned by SchedRemove, SchedReschedule, SchedSetInterval and SchedGetTaskStats when task was not found */
 } sched_status_t;
 
 
+/* the resolution of the timing wheel engine */
+#define SCHED_WHEEL_TICK_NS (1000000UL)
+
+/*
+*	the structure holding the pending tasks. the queue runs a task at its
+*	exact time, but adding and expiring cost O(log n). the wheel does both
+*	in O(1), but rounds every time up to a tick: a task starts up to 
+*	SCHED_WHEEL_TICK_NS late, half a tick on average, and tasks due now 
+*	wait for the next tick. up to a few thousand tasks the queue is the
+*	faster one too. the wheel adds and dispatches faster from about 10^4
+*	pending tasks, twice as fast at 10^5. make bench prints the crossover
+*	on the machine it runs on.
+*/
+typedef enum sched_engine
+{
+	SCHED_QUEUE, /* priority queue ordered by time to run - O(log n) add */
+	SCHED_WHEEL  /* hierarchical timing wheel - O(1) add and expiry */
+} sched_engine_t;
+
+/*
+*	Threading: while a SchedRun or SchedRunParallel is active, SchedAdd*, SchedRemove*, 
+*	SchedReschedule, SchedSetInterval, SchedGetTaskStats, SchedClear, SchedStop,
+*	SchedSize and SchedIsEmpty may be called from any thread. calls from
+*	other threads are queued lock-free and applied by SchedRun before it
+*	runs the next task. all other functions, and every call while no
+*	SchedRun is active, must come from one thread at a time.
+*	a thread other than the owner may only call while it knows SchedRun is
+*	active - started from a task, say - and not ending. one that calls just
+*	as SchedRun starts or returns changes the Scheduler together with it.
+*/
 typedef struct scheduler sched_t;
 
+/* what a periodic task does with the periods it missed while running late */
+typedef enum sched_overrun
+{
+	SCHED_CATCH_UP,     /* run every missed period, back to back. the default */
+	SCHED_SKIP_MISSED,  /* coalesce them into one run, keep the original period grid */
+	SCHED_REANCHOR      /* coalesce them into one run, next run one interval from now */
+} sched_overrun_t;
+
+/* everything SchedAddTask needs to know about a new task */
+typedef struct sched_task_desc
+{
+	uint64_t delay_ns;
+	uint64_t interval_ns;
+	sched_overrun_t overrun;
+	int (*oper_func)(void *param);
+	void *oper_params;
+	void *clean_params;
+	void (*clean_func)(void *param);
+} sched_task_desc_t;
+
+/* what the runs of one task took so far, all times in nanoseconds */
+typedef struct sched_task_stats
+{
+	size_t runs;
+	uint64_t total_run_ns;       /* time spent in oper_func */
+	uint64_t max_run_ns;
+	uint64_t total_lateness_ns;  /* start of a run minus its deadline */
+	uint64_t max_lateness_ns;
+} sched_task_stats_t;
+
+#define SCHED_HIST_BUCKETS (32)
+
+/* 
+*  a log2 histogram of nanoseconds. bucket i counts the values in 
+*  [2^i, 2^(i+1)), bucket 0 also counts 0 and the last bucket counts 
+*  everything from 2^(SCHED_HIST_BUCKETS - 1) up, about 2 seconds.
+*/
+typedef struct sched_histogram
+{
+	size_t buckets[SCHED_HIST_BUCKETS];
+} sched_histogram_t;
+
+/* what the scheduler did so far, all times in nanoseconds */
+typedef struct sched_stats
+{
+	size_t runs;                    /* task runs */
+	size_t wakeups;                 /* times the run loop woke up from waiting */
+	uint64_t loop_ns;               /* time spent in SchedRun and SchedRunParallel */
+	uint64_t busy_ns;               /* time spent running tasks, summed over the workers */
+	uint64_t idle_ns;               /* time the run loop spent waiting */
+	sched_histogram_t run_ns;       /* how long each run took */
+	sched_histogram_t lateness_ns;  /* how long after its deadline each run started */
+} sched_stats_t;
+
+typedef struct sched_overrun_stats
+{
+	size_t missed;     /* periods whose deadline passed before they could run */
+	size_t coalesced;  /* missed periods dropped by SCHED_SKIP_MISSED or SCHED_REANCHOR */
+} sched_overrun_stats_t;
+
 /*
 *	creates a new Scheduler
 *
-*	Arguments: None		
+*	Arguments:
+*		engine - SCHED_QUEUE or SCHED_WHEEL.
 *
 *	Return: a new Scheduler pointer if successful
 *				otherwise return NULL.
@@ -45,7 +136,7 @@ typedef struct scheduler sched_t;
 *	Time complexity: O(1) best/average/worst
 *	Space complexity: O(1) best/average/worst
 */
-sched_t *SchedCreate(void);
+sched_t *SchedCreate(sched_engine_t engine);
 
 /*
 *	frees all memory allocated for the Scheduler
@@ -55,7 +146,7 @@ sched_t *SchedCreate(void);
 *
 *	Return: void.
 *
-*	Time complexity: O(n) best/average/worst
+*	Time complexity: same as SchedClear
 *	Space complexity: O(1) best/average/worst
 */
 void SchedDestroy(sched_t *sched);
@@ -75,7 +166,8 @@ void SchedDestroy(sched_t *sched);
 *	Return: UID - success,
 *			NULL- failure.
 *
-*	Time complexity: O(1) best, O(n) - average/worst
+*	Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
 *	Space complexity: O(1) best/average/worst
 */
 ilrd_uid_t SchedAdd(sched_t *sched,
@@ -86,6 +178,78 @@ ilrd_uid_t SchedAdd(sched_t *sched,
 			   void *clean_func_params,
 			   void (*clean_func)(void *param));
 
+/*
+*	Same as SchedAdd, with the delay and interval in milliseconds.
+*
+*	Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+ilrd_uid_t SchedAddMs(sched_t *sched,
+			   size_t delay_ms,
+			   size_t interval_ms,
+			   int (*oper_func)(void *param),
+			   void *operation_func_params,
+			   void *clean_func_params,
+			   void (*clean_func)(void *param));
+
+/*
+*	Same as SchedAdd, with the delay and interval in nanoseconds. the times
+*	are measured on the monotonic clock, so changing the wall clock does
+*	not move the tasks. the wheel engine rounds them up to SCHED_WHEEL_TICK_NS.
+*
+*	Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+ilrd_uid_t SchedAddNs(sched_t *sched,
+			   uint64_t delay_ns,
+			   uint64_t interval_ns,
+			   int (*oper_func)(void *param),
+			   void *operation_func_params,
+			   void *clean_func_params,
+			   void (*clean_func)(void *param));
+
+/*
+*	Same as SchedAddNs, with the task described by desc. the Sched* add 
+*	functions above use SCHED_CATCH_UP.
+*
+*	Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		desc - the task. oper_func and clean_func must be valid.
+*
+*	Return: UID - success,
+*			NULL- failure.
+*
+*	Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+ilrd_uid_t SchedAddTask(sched_t *sched, const sched_task_desc_t *desc);
+
+/*
+*	Add count tasks at once, all of them or none. the queue engine builds 
+*	its heap bottom up when the batch is large next to the tasks already 
+*	in it, so loading n tasks at start up costs O(n) instead of O(n log n).
+*	called from another thread while SchedRun is active, the tasks are 
+*	queued one by one like SchedAddTask.
+*
+*	Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		descs - count tasks, as for SchedAddTask.
+*		count - number of tasks.
+*		uids - receives the UID of descs[i] in uids[i], or UIDBadUID in all
+*			   of them on failure. must hold count UIDs.
+*
+*	Return: SUCCESS, or MEMORY_ERR - no task was added.
+*
+*	Time complexity: queue: O(count) best, O(n + count) average/worst 
+*							- O(count log n) when count is small next to n
+*					 wheel: O(count) best/average/worst
+*	Space complexity: O(count) best/average/worst
+*/
+int SchedAddBatch(sched_t *sched, const sched_task_desc_t *descs, size_t count, ilrd_uid_t *uids);
+
 
 /*
 *    Remove the match task of the given scheduale.
@@ -96,12 +260,76 @@ ilrd_uid_t SchedAdd(sched_t *sched,
 *
 *	 Return: 0 - success,
 *			1- failure.
+*		called from another thread while SchedRun is active, the removal is
+*		queued and SUCCESS means it was queued - an unknown uid is ignored.
+*		the task is found through a uid index, not by a search.
 *
-*    Time complexity: O(n) best/average/worst
+*    Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
 *    Space complexity: O(1) best/average/worst
 */
 int SchedRemove(sched_t *sched, ilrd_uid_t uid);
 
+/*
+*    Remove count tasks, as SchedRemove does for each of them.
+*
+*    Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		uids - count Uniqe Identifications. UIDBadUID is not allowed.
+*		count - number of uids.
+*
+*	 Return: the number of tasks removed - the uids not found are skipped.
+*		called from another thread while SchedRun is active, the number of
+*		removals queued.
+*
+*    Time complexity: queue: O(count) best, O(count log n) - average/worst
+*					 wheel: O(count) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*/
+size_t SchedRemoveBatch(sched_t *sched, const ilrd_uid_t *uids, size_t count);
+
+/*
+*    Move the next run of a task to delay_ns from now, keeping its uid. 
+*    the task is moved inside the engine, not removed and added again. 
+*    a task that is running right now takes the new time once its run 
+*    ends, if it returns OP_CONTINUE. a task that is due, or handed to a 
+*    worker, and did not start yet does not run before the new time.
+*
+*    Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		uid - Uniqe Identification of the task.
+*		delay_ns - the new delay in nanoseconds, from now.
+*
+*	 Return: SUCCESS, NOT_FOUND, or MEMORY_ERR if the task was due and
+*			could not go back to the engine - it runs at its old time.
+*		called from another thread while SchedRun is active, the change is
+*		queued and SUCCESS means it was queued - an unknown uid is ignored.
+*
+*    Time complexity: queue: O(1) best, O(log n) - average/worst
+*					 wheel: O(1) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*/
+int SchedReschedule(sched_t *sched, ilrd_uid_t uid, uint64_t delay_ns);
+
+/*
+*    Change the interval of a task, keeping its uid. the next run keeps its
+*    time, the runs after it are interval_ns apart. to also move the next
+*    run, call SchedReschedule.
+*
+*    Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		uid - Uniqe Identification of the task.
+*		interval_ns - the new interval in nanoseconds.
+*
+*	 Return: SUCCESS or NOT_FOUND.
+*		called from another thread while SchedRun is active, the change is
+*		queued and SUCCESS means it was queued - an unknown uid is ignored.
+*
+*    Time complexity: O(1) best/average/worst
+*    Space complexity: O(1) best/average/worst
+*/
+int SchedSetInterval(sched_t *sched, ilrd_uid_t uid, uint64_t interval_ns);
+
 /*
 *    Start to execute the tasks.
 *
@@ -120,25 +348,98 @@ int SchedRemove(sched_t *sched, ilrd_uid_t uid);
 int SchedRun(sched_t *sched);
 
 /*
-*    Stop to execute tasks.
+*    Same as SchedRun, but the tasks run on a pool of worker threads while
+*    the calling thread only keeps time, so a slow task does not delay the
+*    others. each worker has its own deque of due tasks and idle workers
+*    steal from the others. a task never runs on two workers at once, and a 
+*    periodic task is rescheduled from its previous time once its run ends.
+*    the tasks may only call SchedAdd*, SchedRemove*, SchedReschedule, 
+*    SchedSetInterval, SchedStop, SchedSize and SchedIsEmpty. on return all the workers have exited.
 *
 *    Arguments:
 *		sched - a Scheduler pointer. must be a valid address.
+*		n_workers - number of worker threads. must be positive.
+*
+*	 Return: same as SchedRun. MEMORY_ERR if the workers could not start.
 *			
 *    Time complexity: O(n) best/average/worst
+*    Space complexity: O(n_workers) best/average/worst
+*/
+int SchedRunParallel(sched_t *sched, size_t n_workers);
+
+/*
+*    Stop to execute tasks. a SchedRun waiting for the next task returns 
+*    STOPPED at once. may be called from any thread or signal handler.
+*
+*    Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*			
+*    Time complexity: O(1) best/average/worst
 *    Space complexity: O(1) best/average/worst
 */
 void SchedStop(sched_t *sched);
 
+/*
+*	Get the overrun counters of all the tasks run so far.
+*	may be called from any thread.
+*
+*	Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		stats - receives the counters. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SchedGetOverrunStats(const sched_t *sched, sched_overrun_stats_t *stats);
+
+/*
+*	Get the counters and histograms of all the runs so far. they are kept 
+*	by SchedRun, two clock reads per run, and read one by one, so a copy 
+*	taken while SchedRun is active may miss the run in progress. 
+*	may be called from any thread.
+*
+*	Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		stats - receives the counters. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SchedGetStats(const sched_t *sched, sched_stats_t *stats);
+
+/*
+*	Get what the runs of one task took so far. from another thread while
+*	SchedRun is active, the thread running it reads them between two tasks
+*	and the call waits for it - not from a task of SchedRunParallel, whose
+*	end waits for its tasks.
+*
+*	Arguments:
+*		sched - a Scheduler pointer. must be a valid address.
+*		uid - Uniqe Identification of the task.
+*		stats - receives the counters. must be a valid address.
+*
+*	Return: SUCCESS, NOT_FOUND, or MEMORY_ERR if it could not be queued.
+*		from another thread, also NOT_FOUND if SchedRun returned before it
+*		could answer.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+int SchedGetTaskStats(sched_t *sched, ilrd_uid_t uid, sched_task_stats_t *stats);
+
 /*
 *	Return the number of current tasks in the Scheduler.
 *
 *	Arguments:
 *		sched - a Scheduler pointer. must be a valid address.
 *
-*	Return: number of tasks in the Scheduler.
+*	Return: number of tasks in the Scheduler, including queued adds.
 *
-*	Time complexity: O(n) best/average/worst
+*	Time complexity: O(1) best/average/worst
 *	Space complexity: O(1) best/average/worst
 */
 size_t SchedSize(const sched_t *sched);
@@ -151,7 +452,12 @@ size_t SchedSize(const sched_t *sched);
 *
 *	Return: void.
 *
-*	Time complexity: O(n) best/average/worst
+*		called from another thread while SchedRun is active, the clear is 
+*		queued and applied before the next task runs, and is lost if there is
+*		no memory to queue it.
+*
+*	Time complexity: O(1) if called outside of SchedRun and every task was
+*					 added from the thread owning the Scheduler, O(n) otherwise
 *	Space complexity: O(1) best/average/worst
 */
 void SchedClear(sched_t *sched);
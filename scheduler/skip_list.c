@@ -0,0 +1,380 @@
+/************************************************ 
+EXERCISE      : DS#14: Skip List
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : skip_list.c
+*************************************************/
+
+#include <stddef.h>  /* size_t, offsetof */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+#include <stdint.h>  /* uint64_t */
+
+#include "skip_list.h"
+
+/* a node reaches each next level with probability 1/4 - as many compares
+   as 1/2, with fewer links per node. 16 levels are enough for 2^32 datas */
+#define MAX_HEIGHT      (16)
+#define BITS_PER_LEVEL  (2)
+#define LEVEL_MASK      (3)
+
+typedef struct skip_link
+{
+	skip_iter_t next;
+	skip_iter_t prev;
+} skip_link_t;
+
+struct skip_node
+{
+	void *data;
+	size_t height;
+	skip_link_t links[1];   /* height links, level 0 first */
+};
+
+struct skip_list
+{
+	skip_iter_t head;   /* sentinels of MAX_HEIGHT - head is before the first data, tail is the end */
+	skip_iter_t tail;
+	size_t height;      /* levels in use, the tallest node linked so far */
+	size_t size;
+	uint64_t seed;      /* xorshift state for the node heights */
+	skip_cmp_t cmp;
+};
+
+/* Helper functions */
+static skip_iter_t NewNode(size_t height, void *data);
+static size_t RandomHeight(skip_list_t *list);
+static skip_iter_t Search(const skip_list_t *list, const void *data, skip_iter_t *preds);
+static void Link(skip_list_t *list, skip_iter_t node);
+static void Unlink(skip_iter_t node);
+static int IsInPlace(const skip_list_t *list, skip_iter_t node);
+
+/*-----------------SkipListCreate-----------------*/
+skip_list_t *SkipListCreate(skip_cmp_t cmp)
+{
+	skip_list_t *list = NULL;
+	size_t level = 0;
+	
+	assert(NULL != cmp);
+	
+	list = (skip_list_t *)malloc(sizeof(skip_list_t));
+	if (NULL == list)
+	{
+		return NULL;
+	}
+	
+	list->head = NewNode(MAX_HEIGHT, NULL);
+	list->tail = NewNode(MAX_HEIGHT, NULL);
+	if (NULL == list->head || NULL == list->tail)
+	{
+		free(list->head);
+		free(list->tail);
+		free(list);
+		return NULL;
+	}
+	
+	for (level = 0; level < MAX_HEIGHT; ++level)
+	{
+		list->head->links[level].next = list->tail;
+		list->head->links[level].prev = NULL;
+		list->tail->links[level].next = NULL;
+		list->tail->links[level].prev = list->head;
+	}
+	
+	list->height = 1;
+	list->size = 0;
+	list->seed = ((uint64_t)0x9E3779B9 << 32) | 0x7F4A7C15;
+	list->cmp = cmp;
+	
+	return list;
+}
+
+/*-----------------SkipListDestroy-----------------*/
+void SkipListDestroy(skip_list_t *list)
+{
+	skip_iter_t node = NULL;
+	skip_iter_t next = NULL;
+	
+	assert(NULL != list);
+	
+	for (node = list->head; NULL != node; node = next)
+	{
+		next = node->links[0].next;
+		free(node);
+	}
+	free(list);
+}
+
+/*-----------------SkipListInsert-----------------*/
+skip_iter_t SkipListInsert(skip_list_t *list, void *data)
+{
+	skip_iter_t node = NULL;
+	
+	assert(NULL != list);
+	
+	node = NewNode(RandomHeight(list), data);
+	if (NULL == node)
+	{
+		return list->tail;
+	}
+	
+	Link(list, node);
+	++list->size;
+	
+	return node;
+}
+
+/*-----------------SkipListRemove-----------------*/
+skip_iter_t SkipListRemove(skip_list_t *list, skip_iter_t iter)
+{
+	skip_iter_t next = NULL;
+	
+	assert(NULL != list);
+	assert(iter != list->tail);
+	
+	next = iter->links[0].next;
+	Unlink(iter);
+	free(iter);
+	--list->size;
+	
+	return next;
+}
+
+/*-----------------SkipListUpdate-----------------*/
+void SkipListUpdate(skip_list_t *list, skip_iter_t iter)
+{
+	assert(NULL != list);
+	assert(iter != list->tail);
+	
+	if (IsInPlace(list, iter))
+	{
+		return;
+	}
+	
+	/* out of order the node would mislead the search, it leaves first */
+	Unlink(iter);
+	Link(list, iter);
+}
+
+/*-----------------SkipListFind-----------------*/
+skip_iter_t SkipListFind(const skip_list_t *list, skip_iter_t from, skip_iter_t to, const void *data)
+{
+	skip_iter_t where = NULL;
+	int result = 0;
+	
+	assert(NULL != list);
+	
+	if (from == to)
+	{
+		return to;
+	}
+	
+	result = list->cmp(from->data, data);
+	if (0 <= result)
+	{
+		return (0 == result) ? (from) : (to);
+	}
+	
+	/* to comes before any equal data */
+	if (to != list->tail && 0 > list->cmp(to->data, data))
+	{
+		return to;
+	}
+	
+	/* the datas up to from are less than data, so the first equal one is after from */
+	where = Search(list, data, NULL);
+	if (where == list->tail || 0 != list->cmp(where->data, data))
+	{
+		return to;
+	}
+	
+	return where;
+}
+
+/*-----------------SkipListMerge-----------------*/
+void SkipListMerge(skip_list_t *dest, skip_list_t *src)
+{
+	skip_iter_t node = NULL;
+	
+	assert(NULL != dest);
+	assert(NULL != src);
+	assert(dest->cmp == src->cmp);
+	
+	/* from the back - each node goes before the equal ones moved earlier */
+	while (0 != src->size)
+	{
+		node = src->tail->links[0].prev;
+		Unlink(node);
+		--src->size;
+	
+		Link(dest, node);
+		++dest->size;
+	}
+}
+
+/*-----------------SkipListGetData-----------------*/
+void *SkipListGetData(skip_iter_t iter)
+{
+	assert(NULL != iter);
+	
+	return iter->data;
+}
+
+/*-----------------SkipListBegin-----------------*/
+skip_iter_t SkipListBegin(const skip_list_t *list)
+{
+	assert(NULL != list);
+	
+	return list->head->links[0].next;
+}
+
+/*-----------------SkipListEnd-----------------*/
+skip_iter_t SkipListEnd(const skip_list_t *list)
+{
+	assert(NULL != list);
+	
+	return list->tail;
+}
+
+/*-----------------SkipListNext-----------------*/
+skip_iter_t SkipListNext(skip_iter_t iter)
+{
+	assert(NULL != iter);
+	
+	return iter->links[0].next;
+}
+
+/*-----------------SkipListPrev-----------------*/
+skip_iter_t SkipListPrev(skip_iter_t iter)
+{
+	assert(NULL != iter);
+	
+	return iter->links[0].prev;
+}
+
+/*-----------------SkipListSize-----------------*/
+size_t SkipListSize(const skip_list_t *list)
+{
+	assert(NULL != list);
+	
+	return list->size;
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function allocates an unlinked node with height levels */
+static skip_iter_t NewNode(size_t height, void *data)
+{
+	skip_iter_t node = NULL;
+	
+	node = (skip_iter_t)malloc(offsetof(struct skip_node, links) + height * sizeof(skip_link_t));
+	if (NULL == node)
+	{
+		return NULL;
+	}
+	
+	node->data = data;
+	node->height = height;
+	
+	return node;
+}
+
+/* This function draws the height of a new node, each level with probability 1/4 of the one below */
+static size_t RandomHeight(skip_list_t *list)
+{
+	uint64_t bits = list->seed;
+	size_t height = 1;
+	
+	bits ^= bits << 13;
+	bits ^= bits >> 7;
+	bits ^= bits << 17;
+	list->seed = bits;
+	
+	while (height < MAX_HEIGHT && 0 == (bits & LEVEL_MASK))
+	{
+		++height;
+		bits >>= BITS_PER_LEVEL;
+	}
+	
+	return height;
+}
+
+/* This function returns the first node not less than data. fills preds, if not NULL,
+   with the node before it on each level in use */
+static skip_iter_t Search(const skip_list_t *list, const void *data, skip_iter_t *preds)
+{
+	skip_iter_t node = list->head;
+	skip_iter_t next = NULL;
+	size_t level = list->height;
+	
+	while (0 < level)
+	{
+		--level;
+		for (next = node->links[level].next;
+		     next != list->tail && 0 > list->cmp(next->data, data);
+		     next = node->links[level].next)
+		{
+			node = next;
+		}
+	
+		if (NULL != preds)
+		{
+			preds[level] = node;
+		}
+	}
+	
+	return node->links[0].next;
+}
+
+/* This function links node before the first node not less than its data */
+static void Link(skip_list_t *list, skip_iter_t node)
+{
+	skip_iter_t preds[MAX_HEIGHT];
+	skip_iter_t pred = NULL;
+	skip_iter_t next = NULL;
+	size_t level = 0;
+	
+	Search(list, node->data, preds);
+	for (level = list->height; level < node->height; ++level)
+	{
+		preds[level] = list->head;
+	}
+	if (node->height > list->height)
+	{
+		list->height = node->height;
+	}
+	
+	for (level = 0; level < node->height; ++level)
+	{
+		pred = preds[level];
+		next = pred->links[level].next;
+	
+		node->links[level].prev = pred;
+		node->links[level].next = next;
+		next->links[level].prev = node;
+		pred->links[level].next = node;
+	}
+}
+
+/* This function takes node out of every level, without freeing it */
+static void Unlink(skip_iter_t node)
+{
+	size_t level = 0;
+	
+	for (level = 0; level < node->height; ++level)
+	{
+		node->links[level].prev->links[level].next = node->links[level].next;
+		node->links[level].next->links[level].prev = node->links[level].prev;
+	}
+}
+
+/* This function checks if node is right before the first other node not less than its data */
+static int IsInPlace(const skip_list_t *list, skip_iter_t node)
+{
+	skip_iter_t prev = node->links[0].prev;
+	skip_iter_t next = node->links[0].next;
+	
+	return ((prev == list->head || 0 > list->cmp(prev->data, node->data)) &&
+	        (next == list->tail || 0 <= list->cmp(next->data, node->data)));
+}
@@ -0,0 +1,211 @@
+/************************************************ 
+EXERCISE      : DS#14: Skip List
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : skip_list.h
+*************************************************/
+
+#ifndef __SKIP_LIST_H__
+#define __SKIP_LIST_H__
+
+#include <stddef.h> /* size_t */
+
+typedef struct skip_list skip_list_t;
+typedef struct skip_node *skip_iter_t;
+
+/*
+*    Compare function between two datas.
+*
+*    Arguments:
+*        data1 - a data to compare.
+*        data2 - a data to compare.
+*
+*    Return: integer less than, equal to, or greater than zero if data1 is,
+*            respectively, to be less than, equal, or be greater than data2.
+*
+*/
+typedef int (*skip_cmp_t)(const void *data1, const void *data2);
+
+/*
+*	creates a new empty skip list, sorted ascending
+*
+*	Arguments:
+*		cmp - compare function. can't be NULL.
+*
+*	Return: a new skip list if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_list_t *SkipListCreate(skip_cmp_t cmp);
+
+/*
+*	frees all memory allocated for the skip list
+*
+*	Arguments:
+*		list - skip list to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SkipListDestroy(skip_list_t *list);
+
+/*
+*	insert data before the first data not less than it. in case of failure
+*	the list remain unchanged. iterators stay valid until their data is removed.
+*
+*	Arguments:
+*		list - pointer to the skip list. must be valid.
+*		data - the data to insert.
+*
+*	Return: iterator to the new data, or the list's end upon failure.
+*
+*	Time complexity: O(log n) average, O(n) worst
+*	Space complexity: O(1) average
+*/
+skip_iter_t SkipListInsert(skip_list_t *list, void *data);
+
+/*
+*	remove the data at iter
+*
+*	Arguments:
+*		list - pointer to the skip list holding iter. must be valid.
+*		iter - iterator to the data to remove. must not be the end.
+*
+*	Return: iterator to the data after the removed one.
+*
+*	Time complexity: O(1) average, O(log n) worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListRemove(skip_list_t *list, skip_iter_t iter);
+
+/*
+*	move the data at iter to its sorted place after its key changed. the node
+*	is relinked, not reallocated, so iter stays valid and it can't fail.
+*
+*	Arguments:
+*		list - pointer to the skip list holding iter. must be valid.
+*		iter - iterator to the data whose key changed. must not be the end.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best, O(log n) average, O(n) worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SkipListUpdate(skip_list_t *list, skip_iter_t iter);
+
+/*
+*	find the first data equal to data in a range
+*
+*	Arguments:
+*		list - pointer to the skip list holding the range. must be valid.
+*		from - start of the range (including).
+*		to - end of the range (excluding).
+*		data - the data to find.
+*
+*	Return: iterator to the found data, or to if not found.
+*
+*	Time complexity: O(1) best, O(log n) average, O(n) worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListFind(const skip_list_t *list, skip_iter_t from, skip_iter_t to, const void *data);
+
+/*
+*	move all the datas of src into dest, leaving src empty. datas of src go
+*	before equal datas of dest and keep their order. nodes are relinked,
+*	not reallocated, so it can't fail.
+*
+*	Arguments:
+*		dest - pointer to the skip list to merge into. must be valid.
+*		src - pointer to the skip list to empty. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(m log(n + m)) average, where m is the size of src
+*	Space complexity: O(1) best/average/worst
+*/
+void SkipListMerge(skip_list_t *dest, skip_list_t *src);
+
+/*
+*	get the data at iter
+*
+*	Arguments:
+*		iter - iterator to a data. must not be the end.
+*
+*	Return: the data.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *SkipListGetData(skip_iter_t iter);
+
+/*
+*	get an iterator to the smallest data, or the end if the list is empty
+*
+*	Arguments:
+*		list - pointer to the skip list. must be valid.
+*
+*	Return: iterator to the first data.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListBegin(const skip_list_t *list);
+
+/*
+*	get the iterator after the last data
+*
+*	Arguments:
+*		list - pointer to the skip list. must be valid.
+*
+*	Return: iterator to the end of the list.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListEnd(const skip_list_t *list);
+
+/*
+*	get the iterator to the next data
+*
+*	Arguments:
+*		iter - current iterator. must not be the end.
+*
+*	Return: iterator to the next data or to the end of the list.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListNext(skip_iter_t iter);
+
+/*
+*	get the iterator to the previous data
+*
+*	Arguments:
+*		iter - current iterator. must not be the first data.
+*
+*	Return: iterator to the previous data.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+skip_iter_t SkipListPrev(skip_iter_t iter);
+
+/*
+*	Return the number of datas in the skip list
+*
+*	Arguments:
+*		list - pointer to the skip list. must be valid.
+*
+*	Return: number of datas in the list.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t SkipListSize(const skip_list_t *list);
+
+#endif /* __SKIP_LIST_H__ */
@@ -0,0 +1,188 @@
+/************************************************ 
+EXERCISE      : DS#17: Slab Allocator
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : slab.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+
+#include "slab.h"
+
+/* the strictest alignment an element may need */
+typedef union max_align
+{
+	long l;
+	double d;
+	long double ld;
+	void *p;
+	void (*f)(void);
+} slab_align_t;
+
+#define ALIGN_UP(size) ((((size) + sizeof(slab_align_t) - 1) / sizeof(slab_align_t)) * sizeof(slab_align_t))
+
+typedef union slab_block
+{
+	union slab_block *next;  /* the elements follow the header */
+	slab_align_t align;
+} slab_block_t;
+
+typedef struct free_elem
+{
+	struct free_elem *next;
+} free_elem_t;
+
+/* 
+*  freed elements are reused first. otherwise elements are handed out in 
+*  order from the blocks, and a new block is added only after the last one
+*  is used up. a reset rewinds to the first block.
+*/
+struct slab
+{
+	slab_block_t *blocks;   /* in allocation order */
+	slab_block_t *current;  /* block handing out elements, NULL before the first */
+	size_t next_index;      /* first element of current never handed out */
+	free_elem_t *free_list;
+	size_t elem_size;
+	size_t elems_per_block;
+};
+
+/* Helper functions */
+static slab_block_t *NextBlock(slab_t *slab);
+
+/*-----------------SlabCreate-----------------*/
+slab_t *SlabCreate(size_t elem_size, size_t elems_per_block)
+{
+	slab_t *slab = NULL;
+	
+	assert(0 < elem_size);
+	assert(0 < elems_per_block);
+	
+	slab = (slab_t *)malloc(sizeof(slab_t));
+	if (NULL == slab)
+	{
+		return NULL;
+	}
+	
+	/* a freed element holds the free list link */
+	if (elem_size < sizeof(free_elem_t))
+	{
+		elem_size = sizeof(free_elem_t);
+	}
+	
+	slab->blocks = NULL;
+	slab->current = NULL;
+	slab->next_index = 0;
+	slab->free_list = NULL;
+	slab->elem_size = ALIGN_UP(elem_size);
+	slab->elems_per_block = elems_per_block;
+	
+	return slab;
+}
+
+/*-----------------SlabDestroy-----------------*/
+void SlabDestroy(slab_t *slab)
+{
+	slab_block_t *block = NULL;
+	
+	assert(NULL != slab);
+	
+	while (NULL != slab->blocks)
+	{
+		block = slab->blocks;
+		slab->blocks = block->next;
+		free(block);
+	}
+	
+	free(slab);
+}
+
+/*-----------------SlabAlloc-----------------*/
+void *SlabAlloc(slab_t *slab)
+{
+	free_elem_t *elem = NULL;
+	slab_block_t *block = NULL;
+	
+	assert(NULL != slab);
+	
+	if (NULL != slab->free_list)
+	{
+		elem = slab->free_list;
+		slab->free_list = elem->next;
+		
+		return elem;
+	}
+	
+	if (NULL == slab->current || slab->next_index == slab->elems_per_block)
+	{
+		block = NextBlock(slab);
+		if (NULL == block)
+		{
+			return NULL;
+		}
+		
+		slab->current = block;
+		slab->next_index = 0;
+	}
+	
+	elem = (free_elem_t *)((char *)(slab->current + 1) + slab->next_index * slab->elem_size);
+	++slab->next_index;
+	
+	return elem;
+}
+
+/*-----------------SlabFree-----------------*/
+void SlabFree(slab_t *slab, void *elem)
+{
+	free_elem_t *freed = (free_elem_t *)elem;
+	
+	assert(NULL != slab);
+	assert(NULL != elem);
+	
+	freed->next = slab->free_list;
+	slab->free_list = freed;
+}
+
+/*-----------------SlabReset-----------------*/
+void SlabReset(slab_t *slab)
+{
+	assert(NULL != slab);
+	
+	slab->current = NULL;
+	slab->next_index = 0;
+	slab->free_list = NULL;
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function returns the block after current, allocating it if there is none */
+static slab_block_t *NextBlock(slab_t *slab)
+{
+	slab_block_t *block = (NULL == slab->current) ? (slab->blocks) : (slab->current->next);
+	
+	if (NULL != block)
+	{
+		return block;
+	}
+	
+	block = (slab_block_t *)malloc(sizeof(slab_block_t) + slab->elems_per_block * slab->elem_size);
+	if (NULL == block)
+	{
+		return NULL;
+	}
+	
+	block->next = NULL;
+	if (NULL == slab->current)
+	{
+		slab->blocks = block;
+	}
+	else
+	{
+		slab->current->next = block;
+	}
+	
+	return block;
+}
@@ -0,0 +1,89 @@
+/************************************************ 
+EXERCISE      : DS#17: Slab Allocator
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : slab.h
+*************************************************/
+
+#ifndef __SLAB_H__
+#define __SLAB_H__
+
+#include <stddef.h> /* size_t */
+
+/* 
+*  hands out fixed size elements carved from big blocks, so allocating and
+*  freeing an element never calls malloc once the blocks exist. the blocks
+*  are kept until SlabDestroy. not thread safe - one thread at a time.
+*/
+typedef struct slab slab_t;
+
+/*
+*	creates a new empty slab. no block is allocated yet.
+*
+*	Arguments:
+*		elem_size - size of every element in bytes. must be positive.
+*		elems_per_block - number of elements in a block. must be positive.
+*
+*	Return: a new slab if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+slab_t *SlabCreate(size_t elem_size, size_t elems_per_block);
+
+/*
+*	frees the slab with all its blocks. every element becomes invalid.
+*
+*	Arguments:
+*		slab - slab to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(number of blocks) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SlabDestroy(slab_t *slab);
+
+/*
+*	allocate an element, aligned for any type.
+*
+*	Arguments:
+*		slab - pointer to the slab. must be valid.
+*
+*	Return: the element, or NULL if a new block could not be allocated.
+*
+*	Time complexity: O(1) best/average, a new block when all are in use
+*	Space complexity: O(1) amortized
+*/
+void *SlabAlloc(slab_t *slab);
+
+/*
+*	return an element to the slab.
+*
+*	Arguments:
+*		slab - pointer to the slab. must be valid.
+*		elem - an element allocated from this slab and not freed.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SlabFree(slab_t *slab, void *elem);
+
+/*
+*	free every element at once. the blocks are kept for reuse.
+*
+*	Arguments:
+*		slab - pointer to the slab. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SlabReset(slab_t *slab);
+
+#endif /* __SLAB_H__ */
@@ -12,15 +12,23 @@ File          : sorted_list.c
 #include <stdlib.h>  /* malloc */
 
 #include "sorted_list.h"
+#include "skip_list.h"
+#include "sorted_vector.h"
 
-static sorted_list_iter_t DIterToSortIter(dlist_iter_t d_iter ,sorted_list_t *list);
+enum status {SUCCESS = 0 , FAILURE = 1};
+
+static sorted_list_iter_t DIterToSortIter(void *internal_iter ,sorted_list_t *list);
 static dlist_iter_t SortIterToDIter(sorted_list_iter_t iter);
 static int LocationToInsert(const void *iter_data , const void *util);
 static int BooleanMatch(const void *iter_data , const void *util); 
+static int GoesAfter(const void *iter_data , const void *util);
 
 struct sorted_list
 {
-	dlist_t *dlist;
+	sorted_list_backend_t backend;
+	dlist_t *dlist;            /* SORTED_LIST_DLIST */
+	skip_list_t *skip;         /* SORTED_LIST_SKIP */
+	sorted_vector_t *vector;   /* SORTED_LIST_VECTOR */
 	sorted_list_cmp_t cmp;
 };
 
@@ -31,11 +39,12 @@ typedef struct cmp_util
 } cmp_util_t;
 
 /*-----------------SortedListCreate-----------------*/
-sorted_list_t *SortedListCreate(sorted_list_cmp_t func)
+sorted_list_t *SortedListCreate(sorted_list_cmp_t func, sorted_list_backend_t backend)
 {
 	sorted_list_t *list = NULL;
 	
 	assert(NULL != func);
+	assert(SORTED_LIST_DLIST == backend || SORTED_LIST_SKIP == backend || SORTED_LIST_VECTOR == backend);
 	
 	list = (sorted_list_t *)malloc(sizeof(sorted_list_t) );
 	if (NULL == list)
@@ -43,15 +52,31 @@ sorted_list_t *SortedListCreate(sorted_list_cmp_t func)
 		return NULL;
 	}
 	
-	list->dlist = DListCreate();
-	if (NULL == list->dlist)
+	list->backend = backend;
+	list->dlist = NULL;
+	list->skip = NULL;
+	list->vector = NULL;
+	list->cmp = func;
+	
+	if (SORTED_LIST_SKIP == backend)
+	{
+		list->skip = SkipListCreate(func);
+	}
+	else if (SORTED_LIST_VECTOR == backend)
+	{
+		list->vector = SortedVectorCreate(func);
+	}
+	else
+	{
+		list->dlist = DListCreate();
+	}
+	
+	if (NULL == list->dlist && NULL == list->skip && NULL == list->vector)
 	{
 		free(list);
 		return NULL;
 	}
 	
-	list->cmp = func;
-	
 	return list;
 }
 		
@@ -60,7 +85,18 @@ void SortedListDestroy(sorted_list_t *list)
 {
 	assert(NULL != list);
 	
-	DListDestroy(list->dlist);
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		SkipListDestroy(list->skip);
+	}
+	else if (SORTED_LIST_VECTOR == list->backend)
+	{
+		SortedVectorDestroy(list->vector);
+	}
+	else
+	{
+		DListDestroy(list->dlist);
+	}
 	free(list);
 }
 
@@ -82,6 +118,15 @@ sorted_list_iter_t SortedListInsert(sorted_list_t *list, void *data_to_insert)
 	
 	assert(NULL != list); 
 	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return DIterToSortIter(SkipListInsert(list->skip , data_to_insert) , list);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return DIterToSortIter(SortedVectorInsert(list->vector , data_to_insert) , list);
+	}
+	
 	begin = DListGetBegin(list->dlist);
 	end = DListGetEnd(list->dlist);
 	
@@ -95,6 +140,90 @@ sorted_list_iter_t SortedListInsert(sorted_list_t *list, void *data_to_insert)
 	return DIterToSortIter(new_iter , list);
 }
 
+/*-----------------SortedListInsertHint-----------------*/
+sorted_list_iter_t SortedListInsertHint(sorted_list_t *list, sorted_list_iter_t hint, void *data_to_insert)
+{
+	dlist_iter_t begin = NULL;
+	dlist_iter_t end = NULL;
+	dlist_iter_t where = NULL;
+	cmp_util_t util = {NULL};
+	
+	assert(NULL != list);
+	assert(hint.list == list);
+	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return SortedListInsert(list , data_to_insert);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return DIterToSortIter(SortedVectorInsertHint(list->vector , hint.internal_iter , data_to_insert) , list);
+	}
+	
+	begin = DListGetBegin(list->dlist);
+	end = DListGetEnd(list->dlist);
+	where = SortIterToDIter(hint);
+	
+	util.cmp = list->cmp;
+	util.data = data_to_insert;
+	
+	if (!DListIsEqual(where , end) && !LocationToInsert(DListGetData(where) , &util))
+	{
+		/* the data goes after hint - search forward, like SortedListInsert */
+		where = DListFind(DListNext(where) , end , &LocationToInsert , &util);
+	}
+	else
+	{
+		/* the data goes before hint - back up over the datas not less than it */
+		while (!DListIsEqual(where , begin) && LocationToInsert(DListGetData(DListPrev(where)) , &util))
+		{
+			where = DListPrev(where);
+		}
+	}
+	
+	return DIterToSortIter(DListInsert(where , data_to_insert) , list);
+}
+
+/*-----------------SortedListUpdate-----------------*/
+void SortedListUpdate(sorted_list_t *list, sorted_list_iter_t iter)
+{
+	dlist_iter_t node = NULL;
+	dlist_iter_t where = NULL;
+	cmp_util_t util = {NULL};
+	
+	assert(NULL != list);
+	assert(iter.list == list);
+	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		SkipListUpdate(list->skip , iter.internal_iter);
+		return;
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		SortedVectorUpdate(list->vector , iter.internal_iter);
+		return;
+	}
+	
+	node = SortIterToDIter(iter);
+	
+	util.cmp = list->cmp;
+	util.data = DListGetData(node);
+	
+	/* the data compares equal to itself, so the search stops at node at the latest */
+	where = DListFind(DListGetBegin(list->dlist) , DListGetEnd(list->dlist) , &LocationToInsert , &util);
+	if (DListIsEqual(where , node))
+	{
+		where = DListFind(DListNext(node) , DListGetEnd(list->dlist) , &LocationToInsert , &util);
+		if (DListIsEqual(where , DListNext(node)))
+		{
+			return;
+		}
+	}
+	
+	DListSplice(node , DListNext(node) , where);
+}
+
 /*-----------------SortedListFind-----------------*/
 sorted_list_iter_t SortedListFind(sorted_list_t *list, sorted_list_iter_t from, sorted_list_iter_t to, const void *to_find)
 {
@@ -107,6 +236,15 @@ sorted_list_iter_t SortedListFind(sorted_list_t *list, sorted_list_iter_t from,
 	assert(NULL != list);
 	assert(from.list == to.list);
 	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return DIterToSortIter(SkipListFind(list->skip , from.internal_iter , to.internal_iter , to_find) , list);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return DIterToSortIter(SortedVectorFind(list->vector , from.internal_iter , to.internal_iter , to_find) , list);
+	}
+	
 	util.cmp = list->cmp;
 	util.data = (void*)to_find; 
 
@@ -121,9 +259,18 @@ sorted_list_iter_t SortedListFind(sorted_list_t *list, sorted_list_iter_t from,
 /*-----------------SortedListRemove-----------------*/
 sorted_list_iter_t SortedListRemove(sorted_list_iter_t iter)
 {
-	dlist_iter_t where = SortIterToDIter(iter);
-	
-	iter.internal_iter = DListRemove(where);
+	if (SORTED_LIST_SKIP == iter.list->backend)
+	{
+		iter.internal_iter = SkipListRemove(iter.list->skip , iter.internal_iter);
+	}
+	else if (SORTED_LIST_VECTOR == iter.list->backend)
+	{
+		iter.internal_iter = SortedVectorRemove(iter.list->vector , iter.internal_iter);
+	}
+	else
+	{
+		iter.internal_iter = DListRemove(SortIterToDIter(iter));
+	}
 	
 	return iter;
 }
@@ -131,31 +278,72 @@ sorted_list_iter_t SortedListRemove(sorted_list_iter_t iter)
 /*-----------------SortedListGetData-----------------*/
 void *SortedListGetData(sorted_list_iter_t cur)
 {
-	dlist_iter_t d_curr = SortIterToDIter(cur);
+	if (SORTED_LIST_SKIP == cur.list->backend)
+	{
+		return SkipListGetData(cur.internal_iter);
+	}
+	if (SORTED_LIST_VECTOR == cur.list->backend)
+	{
+		return SortedVectorGetData(cur.internal_iter);
+	}
 	
-	return DListGetData(d_curr);
+	return DListGetData(SortIterToDIter(cur));
 }
 
 /*-----------------SortedListPopFront-------------------------- */
 void *SortedListPopFront(sorted_list_t *list)
 {
+	sorted_list_iter_t first = {NULL};
+	void *data = NULL;
+	
 	assert(NULL != list);
 	
-	return DListPopFront(list->dlist);
+	if (SORTED_LIST_DLIST == list->backend)
+	{
+		return DListPopFront(list->dlist);
+	}
+	
+	first = SortedListBegin(list);
+	data = SortedListGetData(first);
+	SortedListRemove(first);
+	
+	return data;
 }
 
 /*-----------------SortedListPopBack-------------------------- */
 void *SortedListPopBack(sorted_list_t *list)
 {
+	sorted_list_iter_t last = {NULL};
+	void *data = NULL;
+	
 	assert(NULL != list);
 	
-	return DListPopEnd(list->dlist);
+	if (SORTED_LIST_DLIST == list->backend)
+	{
+		return DListPopEnd(list->dlist);
+	}
+	
+	last = SortedListPrev(SortedListEnd(list));
+	data = SortedListGetData(last);
+	SortedListRemove(last);
+	
+	return data;
 }
 
 /*-----------------SortedListSize-------------------------- */
 size_t SortedListSize(const sorted_list_t *list)
 {
 	assert(NULL != list);
+	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return SkipListSize(list->skip);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return SortedVectorSize(list->vector);
+	}
+	
 	return DListCount(list -> dlist);
 }
 
@@ -164,10 +352,21 @@ int SortedListForEach(sorted_list_iter_t from, sorted_list_iter_t to, action_fun
 {
 	dlist_iter_t d_from = NULL;
 	dlist_iter_t d_to = NULL;	
+	int result = 0;
 	
 	assert(NULL != func);
 	assert(from.list == to.list);
 	
+	if (SORTED_LIST_DLIST != from.list->backend)
+	{
+		for (; !SortedListIsEqual(from , to) && 0 == result; from = SortedListNext(from))
+		{
+			result = func(SortedListGetData(from) , func_param);
+		}
+		
+		return result;
+	}
+	
 	d_from = SortIterToDIter(from);
 	d_to = SortIterToDIter(to);
 	
@@ -179,6 +378,15 @@ sorted_list_iter_t SortedListBegin(const sorted_list_t *list)
 {
 	assert(NULL != list);
 	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return DIterToSortIter(SkipListBegin(list->skip) , (sorted_list_t *)list);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return DIterToSortIter(SortedVectorBegin(list->vector) , (sorted_list_t *)list);
+	}
+	
 	return DIterToSortIter(DListGetBegin(list -> dlist) , (sorted_list_t *)list);
 }
 
@@ -187,32 +395,54 @@ sorted_list_iter_t SortedListEnd(const sorted_list_t *list)
 {
 	assert(NULL != list);
 	
+	if (SORTED_LIST_SKIP == list->backend)
+	{
+		return DIterToSortIter(SkipListEnd(list->skip) , (sorted_list_t *)list);
+	}
+	if (SORTED_LIST_VECTOR == list->backend)
+	{
+		return DIterToSortIter(SortedVectorEnd(list->vector) , (sorted_list_t *)list);
+	}
+	
 	return DIterToSortIter(DListGetEnd(list -> dlist) , (sorted_list_t *)list);
 }
 
 /*-----------------SortedListNext-------------------------- */
 sorted_list_iter_t SortedListNext(sorted_list_iter_t cur)
 {
-	dlist_iter_t d_curr = SortIterToDIter(cur);
-	
-	#ifndef NDEBUG
-	return DIterToSortIter(DListNext(d_curr), cur.list);	
-	#else
-	return DIterToSortIter(DListNext(d_curr), NULL);
-	#endif
+	if (SORTED_LIST_SKIP == cur.list->backend)
+	{
+		cur.internal_iter = SkipListNext(cur.internal_iter);
+	}
+	else if (SORTED_LIST_VECTOR == cur.list->backend)
+	{
+		cur.internal_iter = (sorted_vector_iter_t)cur.internal_iter + 1;
+	}
+	else
+	{
+		cur.internal_iter = DListNext(SortIterToDIter(cur));
+	}
 	
+	return cur;
 }
 
 /*-----------------SortedListPrev-------------------------- */
 sorted_list_iter_t SortedListPrev(sorted_list_iter_t cur)
 {
-	dlist_iter_t d_curr = SortIterToDIter(cur);
-
-	#ifndef NDEBUG
-	return DIterToSortIter(DListPrev(d_curr), cur.list);	
-	#else
-	return DIterToSortIter(DListPrev(d_curr), NULL);
-	#endif
+	if (SORTED_LIST_SKIP == cur.list->backend)
+	{
+		cur.internal_iter = SkipListPrev(cur.internal_iter);
+	}
+	else if (SORTED_LIST_VECTOR == cur.list->backend)
+	{
+		cur.internal_iter = (sorted_vector_iter_t)cur.internal_iter - 1;
+	}
+	else
+	{
+		cur.internal_iter = DListPrev(SortIterToDIter(cur));
+	}
+	
+	return cur;
 }
 
 /*-----------------SortedListIsEmpty------------------------ */
@@ -220,11 +450,16 @@ int SortedListIsEmpty(const sorted_list_t *list)
 {
 	assert(NULL != list);
 	
+	if (SORTED_LIST_DLIST != list->backend)
+	{
+		return (0 == SortedListSize(list));
+	}
+	
 	return DListIsEmpty(list->dlist);
 }
 
 /*-----------------SortedListMerge-------------------------- */
-void SortedListMerge(sorted_list_t *dest, sorted_list_t *src)
+int SortedListMerge(sorted_list_t *dest, sorted_list_t *src)
 {
 	dlist_iter_t from = NULL;
 	dlist_iter_t to = NULL;
@@ -237,6 +472,17 @@ void SortedListMerge(sorted_list_t *dest, sorted_list_t *src)
 	
 	assert(NULL != dest);
 	assert(NULL != src);
+	assert(dest->backend == src->backend);
+	
+	if (SORTED_LIST_SKIP == dest->backend)
+	{
+		SkipListMerge(dest->skip , src->skip);
+		return SUCCESS;
+	}
+	if (SORTED_LIST_VECTOR == dest->backend)
+	{
+		return SortedVectorMerge(dest->vector , src->vector);
+	}
 
 	util.cmp = dest->cmp;
 		
@@ -262,22 +508,23 @@ void SortedListMerge(sorted_list_t *dest, sorted_list_t *src)
 			break; 
 		}
 		
-		/* figure out the ending position of the splice */
+		/* figure out the ending position of the splice - datas equal to where go before it, 
+		   so at least from is spliced */
 		util.data = DListGetData(where); 
-		to = DListFind(from , end_src , &LocationToInsert , &util);
+		to = DListFind(from , end_src , &GoesAfter , &util);
 		
 		/* perform the splice */
 		DListSplice(from , to , where);   
 	}
+	
+	return SUCCESS;
 }
 
 /*-----------------SortedListIsEqual-------------------------- */
 int SortedListIsEqual(sorted_list_iter_t it1 , sorted_list_iter_t it2)
 {
-	dlist_iter_t d_it1 = SortIterToDIter(it1);
-	dlist_iter_t d_it2 = SortIterToDIter(it2);
-	
-	return DListIsEqual(d_it1 , d_it2);
+	/* a node or a slot, by any backend */
+	return (it1.internal_iter == it2.internal_iter);
 }
 
 /*-----------------SortedListFindIf-----------------*/
@@ -288,6 +535,16 @@ sorted_list_iter_t SortedListFindIf(sorted_list_iter_t from, sorted_list_iter_t
 	
 	assert(NULL != func);
 	assert(from.list == to.list);
+	
+	if (SORTED_LIST_DLIST != from.list->backend)
+	{
+		while (!SortedListIsEqual(from , to) && !func(SortedListGetData(from) , param))
+		{
+			from = SortedListNext(from);
+		}
+		
+		return from;
+	}
 
 	d_from = SortIterToDIter(from);
 	d_to = SortIterToDIter(to);	
@@ -302,21 +559,16 @@ sorted_list_iter_t SortedListFindIf(sorted_list_iter_t from, sorted_list_iter_t
 /* This function converts a SortedList iter to DList iter */
 static dlist_iter_t SortIterToDIter(sorted_list_iter_t iter)
 {
-	return (iter.internal_iter);
+	return ((dlist_iter_t)iter.internal_iter);
 }
 
-/* This function converts DList iter to SortedList iter */
-static sorted_list_iter_t DIterToSortIter(dlist_iter_t d_iter ,sorted_list_t *list)
+/* This function converts an iter of the backend of list to SortedList iter */
+static sorted_list_iter_t DIterToSortIter(void *internal_iter ,sorted_list_t *list)
 {
 	sorted_list_iter_t result = {NULL};
 	
-	result.internal_iter = d_iter;	
-	
-	#ifndef NDEBUG
+	result.internal_iter = internal_iter;	
 	result.list = list;
-	#else
-	(void)list;
-	#endif
 	
 	return (result);	
 }
@@ -329,6 +581,14 @@ static int LocationToInsert(const void *iter_data , const void *util)
 	return cmp(iter_data , data_to_insert) >= 0;	
 }
 
+static int GoesAfter(const void *iter_data , const void *util)
+{
+	sorted_list_cmp_t cmp = ((cmp_util_t*)util)->cmp;
+	const void *data  = ((cmp_util_t*)util)->data;
+	
+	return cmp(iter_data , data) > 0;	
+}
+
 static int BooleanMatch(const void *iter_data , const void *util)
 {
 	sorted_list_cmp_t cmp = ((cmp_util_t*)util)->cmp;
@@ -14,16 +14,18 @@ File          : sorted_list.h
 typedef struct sorted_list_iter sorted_list_iter_t;
 typedef struct sorted_list sorted_list_t;
 
-struct sorted_list_iter	
+/* the storage behind the list */
+typedef enum sorted_list_backend
 {
-	dlist_iter_t internal_iter; 
-	
-	#ifndef NDEBUG
-
-	sorted_list_t *list;
-	
-	#endif /* NDEBUG */
+	SORTED_LIST_DLIST,  /* doubly linked list - O(n) insert and find */
+	SORTED_LIST_SKIP,   /* skip list - O(log n) insert and find, O(1) remove */
+	SORTED_LIST_VECTOR  /* sorted array - O(log n) find, O(n) insert in few cache lines */
+} sorted_list_backend_t;
 
+struct sorted_list_iter	
+{
+	void *internal_iter;  /* dlist_iter_t, skip_iter_t or sorted_vector_iter_t, by the backend */
+	sorted_list_t *list;  /* the backend of internal_iter */
 };
 
 
@@ -64,10 +66,14 @@ typedef int (*sorted_list_cmp_t)(const void *data1 , const void *data2);
 
 /*
 *
-*    Creates a new empty sorted linked list
+*    Creates a new empty sorted linked list.
+*    iterators of SORTED_LIST_DLIST and SORTED_LIST_SKIP stay valid until 
+*    their data is removed. any change to a SORTED_LIST_VECTOR list 
+*    invalidates its iterators.
 *
 *    Arguments:
 *		func: the function determining the sorting criteria. can't be NULL.
+*		backend: the storage to use.
 *
 *    Return: a pointer to the new sorted linked list if successful
 *                otherwise return NULL.
@@ -76,7 +82,7 @@ typedef int (*sorted_list_cmp_t)(const void *data1 , const void *data2);
 *    Space complexity: O(1) best/average/worst
 *
 */
-sorted_list_t *SortedListCreate(sorted_list_cmp_t func);
+sorted_list_t *SortedListCreate(sorted_list_cmp_t func, sorted_list_backend_t backend);
 
 /*
 *
@@ -103,7 +109,7 @@ void SortedListDestroy(sorted_list_t *list);
 *
 *    Return: the next valid iterator.
 *
-*    Time complexity: O(1) best/average/worst
+*    Time complexity: O(1) best/average/worst, O(n) average/worst for SORTED_LIST_VECTOR
 *    Space complexity: O(1) best/average/worst
 *
 */
@@ -120,12 +126,52 @@ sorted_list_iter_t SortedListRemove(sorted_list_iter_t iter);
 *
 *    Return: iterator to the new data if successful or to the list's end upon fail
 *
-*    Time complexity: O(1) best O(n) average/worst
+*    Time complexity: O(1) best O(n) average/worst, O(log n) average for SORTED_LIST_SKIP
 *    Space complexity: O(1) best/average/worst
 *
 */
 sorted_list_iter_t SortedListInsert(sorted_list_t *list, void *data_to_insert);
 
+/*
+*
+*    Insert data to the list, searching for its place outward from hint 
+*    instead of from the list's begin. the data lands where SortedListInsert
+*    would put it. in case of failure the list remain unchanged.
+*
+*    Arguments:
+*        list - Pointer to the sorted linked list to which we wish to insert. must be valid.
+*        hint - iterator near the place of the data, like the last insert 
+*               position or the list's end. must be a valid iterator of list.
+*        data_to_insert - The data that we wish to insert to the list.
+*
+*    Return: iterator to the new data if successful or to the list's end upon fail
+*
+*    Time complexity: O(1) best O(d) average/worst, where d is the distance from hint. 
+*                     O(log n) average for SORTED_LIST_SKIP, which doesn't use the hint,
+*                     and O(log n) search for SORTED_LIST_VECTOR when hint is not the place.
+*    Space complexity: O(1) best/average/worst
+*
+*/
+sorted_list_iter_t SortedListInsertHint(sorted_list_t *list, sorted_list_iter_t hint, void *data_to_insert);
+
+/*
+*
+*    Move data to its sorted place after its key changed. the node is
+*    relinked, not reallocated, so iter stays valid and it can't fail.
+*    a SORTED_LIST_VECTOR list moves the data, which invalidates iter.
+*
+*    Arguments:
+*        list - Pointer to the sorted linked list holding iter. must be valid.
+*        iter - iterator to the data whose key changed. must be a valid iterator.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best O(n) average/worst, O(log n) average for SORTED_LIST_SKIP
+*    Space complexity: O(1) best/average/worst
+*
+*/
+void SortedListUpdate(sorted_list_t *list, sorted_list_iter_t iter);
+
 /*
 *    Find data in range in a sorted linked list.
 *
@@ -137,7 +183,8 @@ sorted_list_iter_t SortedListInsert(sorted_list_t *list, void *data_to_insert);
 *
 *    Return: iterator to the found data. iterator to 'to' if not found
 *
-*    Time complexity: O(1) best O(n) average/worst.
+*    Time complexity: O(1) best O(n) average/worst, O(log n) average for SORTED_LIST_SKIP 
+*                     and worst for SORTED_LIST_VECTOR.
 *    Space complexity: O(1) best/average/worst.
 *
 */
@@ -185,7 +232,7 @@ void *SortedListGetData(sorted_list_iter_t cur);
 *
 *    Return: The data from the data removed
 *
-*    Time complexity: O(1) best/average/worst
+*    Time complexity: O(1) best/average/worst, O(n) for SORTED_LIST_VECTOR
 *    Space complexity: O(1) best/average/worst
 *
 */
@@ -215,7 +262,7 @@ void *SortedListPopBack(sorted_list_t *list);
 *
 *    Return: number of elements in the list.
 *
-*    Time complexity: O(n) best/average/worst
+*    Time complexity: O(1) best/average/worst
 *    Space complexity: O(1) best/average/worst
 *
 */
@@ -311,19 +358,22 @@ sorted_list_iter_t SortedListPrev(sorted_list_iter_t cur);
 int SortedListIsEmpty(const sorted_list_t *list);
 
 /*
-*    cuts the data from src and inserts them to dest, while keeping dest sorted
+*    cuts the data from src and inserts them to dest, while keeping dest sorted.
+*    only SORTED_LIST_VECTOR allocates, in case of failure both lists remain unchanged.
 *
 *    Arguments:
 *       dest - pointer to the list that will hold the merged list. can't be NULL.
-*		src - pointer to the list that will be merged into dest. can't be NULL.
+*		src - pointer to the list that will be merged into dest. can't be NULL. 
+*		      must have the backend of dest.
 *
-*    Return: void (always secceeds)
+*    Return: 0 upon success, 1 upon failure
 *
-*    Time complexity: O(n + m) best/average/worst, when n and m are the sizes of sec and dest
-*    Space complexity: O(1) best/average/worst
+*    Time complexity: O(n + m) best/average/worst, when n and m are the sizes of sec and dest.
+*                     O(m log(n + m)) average for SORTED_LIST_SKIP
+*    Space complexity: O(1) best/average/worst, O(n + m) worst for SORTED_LIST_VECTOR
 *
 */
-void SortedListMerge(sorted_list_t *dest, sorted_list_t *src);
+int SortedListMerge(sorted_list_t *dest, sorted_list_t *src);
 
 /*
 *    Checks if two iterators point to the same element
@@ -0,0 +1,304 @@
+/************************************************ 
+EXERCISE      : DS#15: Sorted Vector
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : sorted_vector.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+#include <string.h>  /* memmove */
+
+#include "sorted_vector.h"
+
+enum status {SUCCESS = 0 , FAILURE = 1};
+
+#define INITIAL_CAPACITY (16)
+#define GROWTH_FACTOR    (2)
+
+struct sorted_vector
+{
+	void **datas;
+	size_t size;
+	size_t capacity;
+	sorted_vector_cmp_t cmp;
+};
+
+/* Helper functions */
+static sorted_vector_iter_t LowerBound(sorted_vector_cmp_t cmp, sorted_vector_iter_t from,
+                                       sorted_vector_iter_t to, const void *data);
+static sorted_vector_iter_t InsertAt(sorted_vector_t *vector, sorted_vector_iter_t where, void *data);
+static void OpenSlot(sorted_vector_t *vector, sorted_vector_iter_t where);
+static void CloseSlot(sorted_vector_t *vector, sorted_vector_iter_t where);
+static int Reserve(sorted_vector_t *vector, size_t capacity);
+
+/*-----------------SortedVectorCreate-----------------*/
+sorted_vector_t *SortedVectorCreate(sorted_vector_cmp_t cmp)
+{
+	sorted_vector_t *vector = NULL;
+	
+	assert(NULL != cmp);
+	
+	vector = (sorted_vector_t *)malloc(sizeof(sorted_vector_t));
+	if (NULL == vector)
+	{
+		return NULL;
+	}
+	
+	vector->datas = (void **)malloc(INITIAL_CAPACITY * sizeof(void *));
+	if (NULL == vector->datas)
+	{
+		free(vector);
+		return NULL;
+	}
+	
+	vector->size = 0;
+	vector->capacity = INITIAL_CAPACITY;
+	vector->cmp = cmp;
+	
+	return vector;
+}
+
+/*-----------------SortedVectorDestroy-----------------*/
+void SortedVectorDestroy(sorted_vector_t *vector)
+{
+	assert(NULL != vector);
+	
+	free(vector->datas);
+	free(vector);
+}
+
+/*-----------------SortedVectorInsert-----------------*/
+sorted_vector_iter_t SortedVectorInsert(sorted_vector_t *vector, void *data)
+{
+	assert(NULL != vector);
+	
+	return InsertAt(vector, LowerBound(vector->cmp, vector->datas, vector->datas + vector->size, data), data);
+}
+
+/*-----------------SortedVectorInsertHint-----------------*/
+sorted_vector_iter_t SortedVectorInsertHint(sorted_vector_t *vector, sorted_vector_iter_t hint, void *data)
+{
+	sorted_vector_iter_t begin = NULL;
+	sorted_vector_iter_t end = NULL;
+	
+	assert(NULL != vector);
+	assert(hint >= vector->datas && hint <= vector->datas + vector->size);
+	
+	begin = vector->datas;
+	end = vector->datas + vector->size;
+	
+	if (hint != end && 0 > vector->cmp(*hint, data))
+	{
+		hint = LowerBound(vector->cmp, hint + 1, end, data);
+	}
+	else if (hint != begin && 0 <= vector->cmp(*(hint - 1), data))
+	{
+		hint = LowerBound(vector->cmp, begin, hint - 1, data);
+	}
+	
+	return InsertAt(vector, hint, data);
+}
+
+/*-----------------SortedVectorRemove-----------------*/
+sorted_vector_iter_t SortedVectorRemove(sorted_vector_t *vector, sorted_vector_iter_t iter)
+{
+	assert(NULL != vector);
+	assert(iter >= vector->datas && iter < vector->datas + vector->size);
+	
+	CloseSlot(vector, iter);
+	
+	return iter;
+}
+
+/*-----------------SortedVectorUpdate-----------------*/
+sorted_vector_iter_t SortedVectorUpdate(sorted_vector_t *vector, sorted_vector_iter_t iter)
+{
+	sorted_vector_iter_t where = NULL;
+	void *data = NULL;
+	
+	assert(NULL != vector);
+	assert(iter >= vector->datas && iter < vector->datas + vector->size);
+	
+	data = *iter;
+	
+	/* the slot is closed before the search, the datas around it stay sorted */
+	CloseSlot(vector, iter);
+	where = LowerBound(vector->cmp, vector->datas, vector->datas + vector->size, data);
+	OpenSlot(vector, where);
+	*where = data;
+	
+	return where;
+}
+
+/*-----------------SortedVectorFind-----------------*/
+sorted_vector_iter_t SortedVectorFind(const sorted_vector_t *vector, sorted_vector_iter_t from,
+                                      sorted_vector_iter_t to, const void *data)
+{
+	sorted_vector_iter_t where = NULL;
+	
+	assert(NULL != vector);
+	assert(from <= to);
+	
+	where = LowerBound(vector->cmp, from, to, data);
+	
+	return (where != to && 0 == vector->cmp(*where, data)) ? (where) : (to);
+}
+
+/*-----------------SortedVectorMerge-----------------*/
+int SortedVectorMerge(sorted_vector_t *dest, sorted_vector_t *src)
+{
+	void **dest_data = NULL;
+	void **src_data = NULL;
+	void **where = NULL;
+	
+	assert(NULL != dest);
+	assert(NULL != src);
+	assert(dest->cmp == src->cmp);
+	
+	if (SUCCESS != Reserve(dest, dest->size + src->size))
+	{
+		return FAILURE;
+	}
+	
+	/* from the back, into the free slots of dest - equal datas of dest stay after */
+	dest_data = dest->datas + dest->size;
+	src_data = src->datas + src->size;
+	where = dest->datas + dest->size + src->size;
+	while (src_data != src->datas)
+	{
+		if (dest_data != dest->datas && 0 <= dest->cmp(*(dest_data - 1), *(src_data - 1)))
+		{
+			*--where = *--dest_data;
+		}
+		else
+		{
+			*--where = *--src_data;
+		}
+	}
+	
+	dest->size += src->size;
+	src->size = 0;
+	
+	return SUCCESS;
+}
+
+/*-----------------SortedVectorGetData-----------------*/
+void *SortedVectorGetData(sorted_vector_iter_t iter)
+{
+	assert(NULL != iter);
+	
+	return *iter;
+}
+
+/*-----------------SortedVectorBegin-----------------*/
+sorted_vector_iter_t SortedVectorBegin(const sorted_vector_t *vector)
+{
+	assert(NULL != vector);
+	
+	return vector->datas;
+}
+
+/*-----------------SortedVectorEnd-----------------*/
+sorted_vector_iter_t SortedVectorEnd(const sorted_vector_t *vector)
+{
+	assert(NULL != vector);
+	
+	return vector->datas + vector->size;
+}
+
+/*-----------------SortedVectorSize-----------------*/
+size_t SortedVectorSize(const sorted_vector_t *vector)
+{
+	assert(NULL != vector);
+	
+	return vector->size;
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function returns the first slot in [from, to) whose data is not less than data */
+static sorted_vector_iter_t LowerBound(sorted_vector_cmp_t cmp, sorted_vector_iter_t from,
+                                       sorted_vector_iter_t to, const void *data)
+{
+	size_t count = to - from;
+	size_t half = 0;
+	
+	while (0 < count)
+	{
+		half = count / 2;
+		if (0 > cmp(from[half], data))
+		{
+			from += half + 1;
+			count -= half + 1;
+		}
+		else
+		{
+			count = half;
+		}
+	}
+	
+	return from;
+}
+
+/* This function puts data at where, moving the datas from there one slot up */
+static sorted_vector_iter_t InsertAt(sorted_vector_t *vector, sorted_vector_iter_t where, void *data)
+{
+	size_t index = where - vector->datas;
+	
+	/* growing may move the array */
+	if (SUCCESS != Reserve(vector, vector->size + 1))
+	{
+		return vector->datas + vector->size;
+	}
+	
+	where = vector->datas + index;
+	OpenSlot(vector, where);
+	*where = data;
+	
+	return where;
+}
+
+/* This function moves the datas from where one slot up. the array must have room */
+static void OpenSlot(sorted_vector_t *vector, sorted_vector_iter_t where)
+{
+	memmove(where + 1, where, (vector->datas + vector->size - where) * sizeof(void *));
+	++vector->size;
+}
+
+/* This function moves the datas after where one slot down, over it */
+static void CloseSlot(sorted_vector_t *vector, sorted_vector_iter_t where)
+{
+	--vector->size;
+	memmove(where, where + 1, (vector->datas + vector->size - where) * sizeof(void *));
+}
+
+/* This function enlarges the array to hold at least capacity datas */
+static int Reserve(sorted_vector_t *vector, size_t capacity)
+{
+	void **datas = NULL;
+	size_t new_capacity = vector->capacity;
+	
+	if (capacity <= vector->capacity)
+	{
+		return SUCCESS;
+	}
+	
+	while (new_capacity < capacity)
+	{
+		new_capacity *= GROWTH_FACTOR;
+	}
+	
+	datas = (void **)realloc(vector->datas, new_capacity * sizeof(void *));
+	if (NULL == datas)
+	{
+		return FAILURE;
+	}
+	
+	vector->datas = datas;
+	vector->capacity = new_capacity;
+	
+	return SUCCESS;
+}
@@ -0,0 +1,210 @@
+/************************************************ 
+EXERCISE      : DS#15: Sorted Vector
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : sorted_vector.h
+*************************************************/
+
+#ifndef __SORTED_VECTOR_H__
+#define __SORTED_VECTOR_H__
+
+#include <stddef.h> /* size_t */
+
+/*
+*  a sorted array of datas, searched in binary. inserting or removing moves
+*  the datas after the slot, which stays cheap while they fit in a few
+*  cache lines. any change invalidates the iterators after the changed
+*  slot, a change that grows the array invalidates all of them.
+*/
+
+typedef struct sorted_vector sorted_vector_t;
+typedef void **sorted_vector_iter_t;  /* a slot of the array */
+
+/*
+*    Compare function between two datas.
+*
+*    Arguments:
+*        data1 - a data to compare.
+*        data2 - a data to compare.
+*
+*    Return: integer less than, equal to, or greater than zero if data1 is,
+*            respectively, to be less than, equal, or be greater than data2.
+*
+*/
+typedef int (*sorted_vector_cmp_t)(const void *data1, const void *data2);
+
+/*
+*	creates a new empty sorted vector, sorted ascending
+*
+*	Arguments:
+*		cmp - compare function. can't be NULL.
+*
+*	Return: a new sorted vector if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_t *SortedVectorCreate(sorted_vector_cmp_t cmp);
+
+/*
+*	frees all memory allocated for the sorted vector
+*
+*	Arguments:
+*		vector - sorted vector to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void SortedVectorDestroy(sorted_vector_t *vector);
+
+/*
+*	insert data before the first data not less than it. in case of failure
+*	the vector remain unchanged.
+*
+*	Arguments:
+*		vector - pointer to the sorted vector. must be valid.
+*		data - the data to insert.
+*
+*	Return: iterator to the new data, or the vector's end upon failure.
+*
+*	Time complexity: O(log n) best, O(n) average/worst
+*	Space complexity: O(1) amortized
+*/
+sorted_vector_iter_t SortedVectorInsert(sorted_vector_t *vector, void *data);
+
+/*
+*	insert data like SortedVectorInsert, checking first if it goes right
+*	at hint and searching only the side of hint it goes to otherwise.
+*
+*	Arguments:
+*		vector - pointer to the sorted vector. must be valid.
+*		hint - iterator of vector near the place of data, like the last insert.
+*		data - the data to insert.
+*
+*	Return: iterator to the new data, or the vector's end upon failure.
+*
+*	Time complexity: O(1) best, O(n) average/worst
+*	Space complexity: O(1) amortized
+*/
+sorted_vector_iter_t SortedVectorInsertHint(sorted_vector_t *vector, sorted_vector_iter_t hint, void *data);
+
+/*
+*	remove the data at iter
+*
+*	Arguments:
+*		vector - pointer to the sorted vector holding iter. must be valid.
+*		iter - iterator to the data to remove. must not be the end.
+*
+*	Return: iterator to the data after the removed one, which is now at iter.
+*
+*	Time complexity: O(1) best, O(n) average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_iter_t SortedVectorRemove(sorted_vector_t *vector, sorted_vector_iter_t iter);
+
+/*
+*	move the data at iter to its sorted place after its key changed. it
+*	never allocates, so it can't fail.
+*
+*	Arguments:
+*		vector - pointer to the sorted vector holding iter. must be valid.
+*		iter - iterator to the data whose key changed. must not be the end.
+*
+*	Return: iterator to the data in its new place.
+*
+*	Time complexity: O(1) best, O(n) average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_iter_t SortedVectorUpdate(sorted_vector_t *vector, sorted_vector_iter_t iter);
+
+/*
+*	find the first data equal to data in a range
+*
+*	Arguments:
+*		vector - pointer to the sorted vector holding the range. must be valid.
+*		from - start of the range (including).
+*		to - end of the range (excluding).
+*		data - the data to find.
+*
+*	Return: iterator to the found data, or to if not found.
+*
+*	Time complexity: O(log n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_iter_t SortedVectorFind(const sorted_vector_t *vector, sorted_vector_iter_t from,
+                                      sorted_vector_iter_t to, const void *data);
+
+/*
+*	move all the datas of src into dest, leaving src empty. datas of src go
+*	before equal datas of dest and keep their order. in case of failure
+*	both vectors remain unchanged.
+*
+*	Arguments:
+*		dest - pointer to the sorted vector to merge into. must be valid.
+*		src - pointer to the sorted vector to empty. must be valid.
+*
+*	Return: 0 - success,
+*			1 - failure.
+*
+*	Time complexity: O(n + m) best/average/worst, where m is the size of src
+*	Space complexity: O(n + m) worst
+*/
+int SortedVectorMerge(sorted_vector_t *dest, sorted_vector_t *src);
+
+/*
+*	get the data at iter
+*
+*	Arguments:
+*		iter - iterator to a data. must not be the end.
+*
+*	Return: the data.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *SortedVectorGetData(sorted_vector_iter_t iter);
+
+/*
+*	get an iterator to the smallest data, or the end if the vector is empty
+*
+*	Arguments:
+*		vector - pointer to the sorted vector. must be valid.
+*
+*	Return: iterator to the first data.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_iter_t SortedVectorBegin(const sorted_vector_t *vector);
+
+/*
+*	get the iterator after the last data
+*
+*	Arguments:
+*		vector - pointer to the sorted vector. must be valid.
+*
+*	Return: iterator to the end of the vector.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+sorted_vector_iter_t SortedVectorEnd(const sorted_vector_t *vector);
+
+/*
+*	Return the number of datas in the sorted vector
+*
+*	Arguments:
+*		vector - pointer to the sorted vector. must be valid.
+*
+*	Return: number of datas in the vector.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t SortedVectorSize(const sorted_vector_t *vector);
+
+#endif /* __SORTED_VECTOR_H__ */
@@ -7,11 +7,12 @@ File          : task.c
 *************************************************/
 
 #include <stddef.h>
-#include <time.h>
+#include <stdint.h>
 #include <assert.h>
 #include <stdlib.h>
 #include "task.h"
 #include "uid.h"
+#include "mono_time.h"
 
 enum status
 {
@@ -22,8 +23,15 @@ enum status
 
 struct task
 {
-	time_t execute_time;
-	size_t interval_in_sec;
+	uint64_t execute_time;  /* monotonic nanoseconds */
+	uint64_t interval_ns;
+	uint64_t missed_until;  /* last deadline already counted as missed */
+	uint64_t next_time;     /* replaces the next period if has_next_time */
+	int has_next_time;
+	task_overrun_t overrun;
+	slab_t *pool;           /* NULL if allocated with malloc */
+	task_handle_t handle;   /* where the holder keeps the task */
+	task_stats_t stats;
 	ilrd_uid_t uid;
 	int (*oper_func)(void *param);
 	void *operation_func_param;
@@ -31,33 +39,48 @@ struct task
 	void (*clean_func)(void *param);
 };
 
-task_t *TaskCreate(size_t delay,
-			   	   size_t interval_in_sec,
+task_t *TaskCreate(uint64_t delay_ns,
+			   	   uint64_t interval_ns,
+			   	   task_overrun_t overrun,
 			   	   int (*oper_func)(void *param),
 				   void *operation_func_param,
 				   void *clean_func_param,
-				   void (*clean_func)(void *param))
+				   void (*clean_func)(void *param),
+				   slab_t *pool)
 {
 	task_t *task = NULL;
 	
 	assert(NULL != oper_func);
 	assert(NULL != clean_func);
 	
-	task = (task_t *)malloc(sizeof(task_t));
+	task = (task_t *)((NULL != pool) ? (SlabAlloc(pool)) : (malloc(sizeof(task_t))));
 	if(NULL == task)
 	{
 		return NULL;
 	}
 	
+	task->pool = pool;
+	task->handle.holder = 0;
+	task->handle.index = 0;
+	task->handle.node = NULL;
+	task->stats.runs = 0;
+	task->stats.total_run_ns = 0;
+	task->stats.max_run_ns = 0;
+	task->stats.total_lateness_ns = 0;
+	task->stats.max_lateness_ns = 0;
 	task->uid = UIDCreate();
 	if (UIDIsSame(task->uid, UIDBadUID))
 	{
-		free(task);
+		TaskDestroy(task);
 		return NULL;
 	}
 	
-	task->execute_time = time(NULL) + delay; 
-	task->interval_in_sec = interval_in_sec;
+	task->execute_time = MonoTimeNow() + delay_ns; 
+	task->interval_ns = interval_ns;
+	task->missed_until = 0;
+	task->next_time = 0;
+	task->has_next_time = 0;
+	task->overrun = overrun;
 	task->oper_func = oper_func;
 	task->operation_func_param = operation_func_param;
 	task->clean_func = clean_func;
@@ -66,11 +89,30 @@ task_t *TaskCreate(size_t delay,
 	return task;
 }
 
+size_t TaskObjectSize(void)
+{
+	return sizeof(task_t);
+}
+
+int TaskIsPooled(const task_t *task)
+{
+	assert(NULL != task);
+	
+	return (NULL != task->pool);
+}
+
 void TaskDestroy(task_t *task)
 {
 	assert(NULL != task);
 	
-	free(task);
+	if (NULL != task->pool)
+	{
+		SlabFree(task->pool, task);
+	}
+	else
+	{
+		free(task);
+	}
 	task = NULL;
 }
 
@@ -94,15 +136,126 @@ int TaskIsMatch(ilrd_uid_t uid, const task_t *task)
 	return (UIDIsSame(uid , task->uid));
 }
 
-void TaskUpdateTimeToRun(task_t *task)
+void TaskSetHandle(task_t *task, task_handle_t handle)
+{
+	assert(NULL != task);
+	
+	task->handle = handle;
+}
+
+task_handle_t TaskGetHandle(const task_t *task)
+{
+	assert(NULL != task);
+	
+	return task->handle;
+}
+
+size_t TaskUpdateTimeToRun(task_t *task, uint64_t now)
+{
+	uint64_t first_missed = 0;
+	size_t missed = 0;
+	
+	assert(NULL != task);
+	
+	if (task->has_next_time)
+	{
+		task->execute_time = task->next_time;
+		task->has_next_time = 0;
+		return 0;
+	}
+	
+	task->execute_time += task->interval_ns;
+	
+	if (0 == task->interval_ns || task->execute_time > now)
+	{
+		return 0;
+	}
+	
+	/* a caught up period was already counted when it was first missed */
+	first_missed = task->execute_time;
+	if (task->missed_until >= first_missed)
+	{
+		first_missed = task->missed_until + task->interval_ns;
+	}
+	
+	if (first_missed <= now)
+	{
+		missed = (size_t)((now - first_missed) / task->interval_ns) + 1;
+		task->missed_until = first_missed + (missed - 1) * task->interval_ns;
+	}
+	
+	switch (task->overrun)
+	{
+	case TASK_CATCH_UP:
+			break;
+	
+	case TASK_SKIP_MISSED:
+			/* the first deadline of the grid still ahead */
+			task->execute_time += ((now - task->execute_time) / task->interval_ns + 1) * task->interval_ns;
+			break;
+	
+	case TASK_REANCHOR:
+			task->execute_time = now + task->interval_ns;
+			break;
+	}
+	
+	return missed;
+}
+
+void TaskSetTimeToRun(task_t *task, uint64_t time)
+{
+	assert(NULL != task);
+	
+	task->execute_time = time;
+}
+
+void TaskSetNextTimeToRun(task_t *task, uint64_t time)
+{
+	assert(NULL != task);
+	
+	task->next_time = time;
+	task->has_next_time = 1;
+}
+
+void TaskSetInterval(task_t *task, uint64_t interval_ns)
+{
+	assert(NULL != task);
+	
+	task->interval_ns = interval_ns;
+}
+
+void TaskRecordRun(task_t *task, uint64_t lateness_ns, uint64_t run_ns)
+{
+	assert(NULL != task);
+	
+	++task->stats.runs;
+	task->stats.total_run_ns += run_ns;
+	task->stats.total_lateness_ns += lateness_ns;
+	if (run_ns > task->stats.max_run_ns)
+	{
+		task->stats.max_run_ns = run_ns;
+	}
+	if (lateness_ns > task->stats.max_lateness_ns)
+	{
+		task->stats.max_lateness_ns = lateness_ns;
+	}
+}
+
+task_stats_t TaskGetStats(const task_t *task)
+{
+	assert(NULL != task);
+	
+	return task->stats;
+}
+
+task_overrun_t TaskGetOverrun(const task_t *task)
 {
 	assert(NULL != task);
 	
-	task->execute_time += task->interval_in_sec;
-	 
+	return task->overrun;
 }
 
-time_t TaskGetTimeToRun(const task_t *task)
+uint64_t TaskGetTimeToRun(const task_t *task)
 {
 	assert(NULL != task);
 	
@@ -10,21 +10,51 @@ File          : task.h
 #define __TASK_H__
 
 #include <stddef.h>
-#include <time.h>
+#include <stdint.h>
 #include "uid.h"
+#include "slab.h"
 
 typedef struct task task_t;
 
+/* what a periodic task does with the periods it missed while running late */
+typedef enum task_overrun
+{
+	TASK_CATCH_UP,     /* run every missed period, back to back */
+	TASK_SKIP_MISSED,  /* run once, then continue on the original period grid */
+	TASK_REANCHOR      /* run once, then continue one interval from now */
+} task_overrun_t;
+
+/* where a task is held, so its holder can take it out without a search */
+typedef struct task_handle
+{
+	int holder;    /* which container holds the task, in the holder's own terms */
+	size_t index;  /* a slot of an array, like a heap's */
+	void *node;    /* a linked node, like a list's */
+} task_handle_t;
+
+/* what the runs of a task took so far, all times in nanoseconds */
+typedef struct task_stats
+{
+	size_t runs;
+	uint64_t total_run_ns;
+	uint64_t max_run_ns;
+	uint64_t total_lateness_ns;  /* start minus deadline */
+	uint64_t max_lateness_ns;
+} task_stats_t;
+
 /*
 *	creates a new task
 *
 *	Arguments: 
-*		delay - initial time to run the task in seconds.
-*		interval - a cyclist value for rerun the task.
+*		delay_ns - initial time to run the task in nanoseconds from now.
+*		interval_ns - a cyclist value in nanoseconds for rerun the task.
+*		overrun - what to do with the periods missed while late.
 *		oper_func - pointer to operational function. Must be NULL.
 *		operation_func_param - The parameter that we wish to execute in operational function. Can be NULL.
 *		clean_func - pointer to cleanup function. Must be valid.
 *		clean_func_param - The parameter that we wish to execute in cleanup function. Can be NULL.	
+*		pool - slab of TaskObjectSize() elements to allocate the task from.
+*		       NULL allocates it with malloc.
 *
 *	Return: a new task pointer if successful
 *				otherwise return NULL.
@@ -32,17 +62,44 @@ typedef struct task task_t;
 *	Time complexity: O(1) best/average/worst
 *	Space complexity: O(1) best/average/worst
 */
-task_t *TaskCreate(size_t delay,
-			   	   size_t interval_in_sec,
+task_t *TaskCreate(uint64_t delay_ns,
+			   	   uint64_t interval_ns,
+			   	   task_overrun_t overrun,
 			   	   int (*oper_func)(void *param),
 				   void *operation_func_param,
 				   void *clean_func_param,
-				   void (*clean_func)(void *param));
+				   void (*clean_func)(void *param),
+				   slab_t *pool);
+
+/*
+*	Size of a task, for creating a pool for TaskCreate.
+*
+*	Arguments: None.
+*
+*	Return: size of a task in bytes.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t TaskObjectSize(void);
+
+/*
+*	Checks if the task was allocated from a pool.
+*
+*	Arguments:
+*		task - a task pointer. must be a valid address.
+*
+*	Return: 1 if it was, 0 if it was allocated with malloc.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+int TaskIsPooled(const task_t *task);
 
 
 
 /*
-*	frees all memory allocated for the task
+*	frees all memory allocated for the task, back to its pool if it has one
 *
 *	Arguments:
 *		task - a task pointer. must be a valid address.
@@ -85,17 +142,133 @@ int TaskRun(task_t *task);
 int TaskIsMatch(ilrd_uid_t uid, const task_t *task);
 
 /*
-*    Update the execute time of the given task.
+*    Records where the task is held.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		handle - the position of the task in its holder.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+void TaskSetHandle(task_t *task, task_handle_t handle);
+
+/*
+*    Getting where the task is held, as last set by TaskSetHandle.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*
+*    Return: the handle. all zero before the first TaskSetHandle.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+task_handle_t TaskGetHandle(const task_t *task);
+
+/*
+*    Update the execute time of the given task after a run, according to
+*    its overrun policy. each missed period is counted once, even when
+*    TASK_CATCH_UP runs it later.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		now - the current monotonic time in nanoseconds.
+*
+*    Return: number of periods newly missed, their deadline passed by now.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+size_t TaskUpdateTimeToRun(task_t *task, uint64_t now);
+
+/*
+*    Setting the execute time of the given task. a task held in a sorted
+*    structure must be moved to its new place by its holder.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		time - the new execute time, in nanoseconds of the monotonic clock.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+void TaskSetTimeToRun(task_t *task, uint64_t time);
+
+/*
+*    Setting the execute time the next TaskUpdateTimeToRun gives the task,
+*    in place of its next period. for a task that is running right now.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		time - the next execute time, in nanoseconds of the monotonic clock.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+void TaskSetNextTimeToRun(task_t *task, uint64_t time);
+
+/*
+*    Setting the interval of the given task. the execute time is not
+*    touched, the new interval counts from the next TaskUpdateTimeToRun.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		interval_ns - the new interval in nanoseconds. 0 for a one shot task.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+void TaskSetInterval(task_t *task, uint64_t interval_ns);
+
+/*
+*    Counting a run of the given task in its stats.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*		 		lateness_ns - how long after its deadline the run started.
+*		 		run_ns - how long the run took.
+*
+*    Return: void.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+void TaskRecordRun(task_t *task, uint64_t lateness_ns, uint64_t run_ns);
+
+/*
+*    Getting the stats of the given task.
+*
+*    Arguments:
+*		 		task - a task pointer. must be a valid address.
+*
+*    Return: the stats, all zero before the first TaskRecordRun.
+*
+*    Time complexity: O(1) best/average/worst.
+*    Space complexity: O(1) best/average/worst.
+*/
+task_stats_t TaskGetStats(const task_t *task);
+
+/*
+*    Getting the overrun policy of the given task.
 *
 *    Arguments:
 *		 		task - a task pointer. must be a valid address.
 *
-*    Return: None.
+*    Return: the overrun policy.
 *
 *    Time complexity: O(1) best/average/worst.
 *    Space complexity: O(1) best/average/worst.
 */
-void TaskUpdateTimeToRun(task_t *task);
+task_overrun_t TaskGetOverrun(const task_t *task);
 
 /*
 *    Getting the execute time of the given task.
@@ -103,12 +276,12 @@ void TaskUpdateTimeToRun(task_t *task);
 *    Arguments:
 *		 		task - a task pointer. must be a valid address.
 *
-*    Return: execute time.
+*    Return: execute time, in nanoseconds of the monotonic clock.
 *
 *    Time complexity: O(1) best/average/worst.
 *    Space complexity: O(1) best/average/worst.
 */
-time_t TaskGetTimeToRun(const task_t *task);
+uint64_t TaskGetTimeToRun(const task_t *task);
 
 /*
 *    Getting the Uniqe Identification of the given task.
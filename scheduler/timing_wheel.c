@@ -0,0 +1,536 @@
+/************************************************ 
+EXERCISE      : DS#14: Hierarchical Timing Wheel
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : timing_wheel.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+
+#include "timing_wheel.h"
+#include "slab.h"
+
+#define SLOT_MASK        ((tw_tick_t)TW_SLOTS - 1)
+#define LEVEL_SHIFT(l)   ((l) * TW_LEVEL_BITS)
+#define LEVEL_SPAN(l)    ((tw_tick_t)1 << LEVEL_SHIFT(l))
+#define SLOT_INDEX(t, l) (((t) >> LEVEL_SHIFT(l)) & SLOT_MASK)
+
+#define NODES_PER_BLOCK (256)
+
+struct timing_wheel
+{
+	slab_t *nodes;     /* every slot list takes its nodes from here */
+	dlist_t *slots[TW_LEVELS][TW_SLOTS];
+	dlist_t *pending;  /* timers taken out of a slot while cascading */
+	unsigned long busy[TW_LEVELS]; /* bit per slot, set when a slot may be non empty */
+	tw_tick_t current;
+	tw_tick_t next_expiry;  /* valid while is_next_known */
+	int is_next_known;
+	size_t size;
+	tw_get_tick_t get_tick;
+};
+
+/* Helper functions */
+static dlist_t *SlotOf(tw_t *tw, tw_tick_t expire);
+static long NextBusySlot(tw_t *tw, size_t level, tw_tick_t from);
+static tw_tick_t NextStop(tw_t *tw);
+static tw_tick_t EarliestIn(tw_t *tw, dlist_t *slot);
+static tw_tick_t FindNextExpiry(tw_t *tw);
+static void MoveTo(dlist_iter_t node, dlist_t *dest);
+static void Cascade(tw_t *tw, size_t level);
+static void Advance(tw_t *tw, tw_tick_t now);
+static void DestroySlots(tw_t *tw);
+
+/*-----------------TWCreate-----------------*/
+tw_t *TWCreate(tw_get_tick_t get_tick, tw_tick_t now)
+{
+	tw_t *tw = NULL;
+	size_t level = 0;
+	size_t slot = 0;
+	
+	assert(NULL != get_tick);
+	
+	tw = (tw_t *)calloc(1, sizeof(tw_t));
+	if (NULL == tw)
+	{
+		return NULL;
+	}
+	
+	tw->nodes = SlabCreate(DListNodeSize(), NODES_PER_BLOCK);
+	if (NULL == tw->nodes)
+	{
+		free(tw);
+		return NULL;
+	}
+	
+	tw->pending = DListCreatePooled(tw->nodes);
+	if (NULL == tw->pending)
+	{
+		SlabDestroy(tw->nodes);
+		free(tw);
+		return NULL;
+	}
+	
+	for (level = 0; level < TW_LEVELS; ++level)
+	{
+		for (slot = 0; slot < TW_SLOTS; ++slot)
+		{
+			tw->slots[level][slot] = DListCreatePooled(tw->nodes);
+			if (NULL == tw->slots[level][slot])
+			{
+				DestroySlots(tw);
+				return NULL;
+			}
+		}
+	}
+	
+	tw->current = now;
+	tw->next_expiry = 0;
+	tw->is_next_known = 0;
+	tw->size = 0;
+	tw->get_tick = get_tick;
+	
+	return tw;
+}
+
+/*-----------------TWDestroy-----------------*/
+void TWDestroy(tw_t *tw)
+{
+	assert(NULL != tw);
+	
+	DestroySlots(tw);
+}
+
+/*-----------------TWAdd-----------------*/
+tw_handle_t TWAdd(tw_t *tw, void *data)
+{
+	dlist_t *slot = NULL;
+	dlist_iter_t handle = NULL;
+	tw_tick_t expire = 0;
+	
+	assert(NULL != tw);
+	
+	expire = tw->get_tick(data);
+	slot = SlotOf(tw, expire);
+	
+	handle = DListPushEnd(slot, data);
+	if (DListIsEqual(handle, DListGetEnd(slot)))
+	{
+		return NULL;
+	}
+	
+	/* a timer already due expires at the current tick */
+	if (expire < tw->current)
+	{
+		expire = tw->current;
+	}
+	if (0 == tw->size || (tw->is_next_known && expire < tw->next_expiry))
+	{
+		tw->next_expiry = expire;
+		tw->is_next_known = 1;
+	}
+	
+	++tw->size;
+	
+	return handle;
+}
+
+/*-----------------TWRemove-----------------*/
+void *TWRemove(tw_t *tw, tw_handle_t handle)
+{
+	void *data = NULL;
+	
+	assert(NULL != tw);
+	assert(NULL != handle);
+	
+	data = DListGetData(handle);
+	DListRemove(handle);
+	--tw->size;
+	
+	if (tw->get_tick(data) <= tw->next_expiry)
+	{
+		tw->is_next_known = 0;
+	}
+	
+	return data;
+}
+
+/*-----------------TWUpdate-----------------*/
+void TWUpdate(tw_t *tw, tw_handle_t handle)
+{
+	dlist_t *slot = NULL;
+	
+	assert(NULL != tw);
+	assert(NULL != handle);
+	
+	slot = SlotOf(tw, tw->get_tick(DListGetData(handle)));
+	
+	/* the tick it had before is not known, it may have been the earliest */
+	tw->is_next_known = 0;
+	
+	/* already the last timer of its slot - splicing it before the end would unlink it */
+	if (DListIsEqual(DListNext(handle), DListGetEnd(slot)))
+	{
+		return;
+	}
+	
+	MoveTo(handle, slot);
+}
+
+/*-----------------TWRemoveIf-----------------*/
+void *TWRemoveIf(tw_t *tw, match_func_t is_match, const void *param)
+{
+	size_t level = 0;
+	size_t slot = 0;
+	dlist_t *list = NULL;
+	dlist_iter_t where = NULL;
+	
+	assert(NULL != tw);
+	assert(NULL != is_match);
+	
+	for (level = 0; level < TW_LEVELS; ++level)
+	{
+		for (slot = 0; slot < TW_SLOTS; ++slot)
+		{
+			list = tw->slots[level][slot];
+			where = DListFind(DListGetBegin(list), DListGetEnd(list), is_match, param);
+			if (!DListIsEqual(where, DListGetEnd(list)))
+			{
+				return TWRemove(tw, where);
+			}
+		}
+	}
+	
+	return NULL;
+}
+
+/*-----------------TWPopExpired-----------------*/
+void *TWPopExpired(tw_t *tw, tw_tick_t now)
+{
+	dlist_t *slot = NULL;
+	
+	assert(NULL != tw);
+	
+	for (;;)
+	{
+		slot = tw->slots[0][SLOT_INDEX(tw->current, 0)];
+		if (!DListIsEmpty(slot))
+		{
+			--tw->size;
+			tw->is_next_known = 0;
+			return DListPopFront(slot);
+		}
+		
+		if (tw->current >= now)
+		{
+			return NULL;
+		}
+		
+		if (0 == tw->size)
+		{
+			tw->current = now;
+			return NULL;
+		}
+		
+		Advance(tw, now);
+	}
+}
+
+/*-----------------TWNextExpiry-----------------*/
+tw_tick_t TWNextExpiry(tw_t *tw)
+{
+	assert(NULL != tw);
+	assert(0 != tw->size);
+	
+	/* advancing never passes a timer, so only adding and removing change it */
+	if (!tw->is_next_known)
+	{
+		tw->next_expiry = FindNextExpiry(tw);
+		tw->is_next_known = 1;
+	}
+	
+	return tw->next_expiry;
+}
+
+/*-----------------TWForEach-----------------*/
+int TWForEach(tw_t *tw, action_func_t func, void *param)
+{
+	size_t level = 0;
+	size_t slot = 0;
+	dlist_t *list = NULL;
+	int status = 0;
+	
+	assert(NULL != tw);
+	assert(NULL != func);
+	
+	for (level = 0; level < TW_LEVELS; ++level)
+	{
+		for (slot = 0; slot < TW_SLOTS; ++slot)
+		{
+			list = tw->slots[level][slot];
+			status = DListForEach(DListGetBegin(list), DListGetEnd(list), func, param);
+			if (0 != status)
+			{
+				return status;
+			}
+		}
+	}
+	
+	return status;
+}
+
+/*-----------------TWClear-----------------*/
+void TWClear(tw_t *tw)
+{
+	size_t level = 0;
+	size_t slot = 0;
+	
+	assert(NULL != tw);
+	
+	/* the nodes all go back to the pool at once */
+	for (level = 0; level < TW_LEVELS; ++level)
+	{
+		for (slot = 0; slot < TW_SLOTS; ++slot)
+		{
+			DListReset(tw->slots[level][slot]);
+		}
+		tw->busy[level] = 0;
+	}
+	
+	SlabReset(tw->nodes);
+	tw->size = 0;
+	tw->is_next_known = 0;
+}
+
+/*-----------------TWSize-----------------*/
+size_t TWSize(const tw_t *tw)
+{
+	assert(NULL != tw);
+	
+	return tw->size;
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function finds the slot that holds a timer expiring at expire and marks it busy */
+static dlist_t *SlotOf(tw_t *tw, tw_tick_t expire)
+{
+	size_t level = 0;
+	
+	if (expire < tw->current)
+	{
+		expire = tw->current;
+	}
+	
+	/* beyond the wheel - park in the farthest slot, it is re-cascaded later */
+	if (expire - tw->current >= LEVEL_SPAN(TW_LEVELS))
+	{
+		expire = tw->current + LEVEL_SPAN(TW_LEVELS) - 1;
+	}
+	
+	while (expire - tw->current >= LEVEL_SPAN(level + 1))
+	{
+		++level;
+	}
+	
+	tw->busy[level] |= 1UL << SLOT_INDEX(expire, level);
+	
+	return tw->slots[level][SLOT_INDEX(expire, level)];
+}
+
+/* This function returns how many slots after the slot of from the first busy 
+   slot of level is, or -1 if the level is empty. stale busy bits are cleared */
+static long NextBusySlot(tw_t *tw, size_t level, tw_tick_t from)
+{
+	size_t first = (size_t)(from & SLOT_MASK);
+	unsigned long rotated = 0;
+	size_t slot = 0;
+	long distance = 0;
+	
+	while (0 != tw->busy[level])
+	{
+		/* rotate so that bit 0 is the slot of from */
+		rotated = (0 == first) ? (tw->busy[level]) :
+		          ((tw->busy[level] >> first) | (tw->busy[level] << (TW_SLOTS - first)));
+		distance = __builtin_ctzl(rotated);
+		slot = (first + distance) & SLOT_MASK;
+		
+		if (!DListIsEmpty(tw->slots[level][slot]))
+		{
+			return distance;
+		}
+		
+		tw->busy[level] &= ~(1UL << slot);
+	}
+	
+	return -1;
+}
+
+/* This function finds the next tick the wheel has to stop at - the expiry of
+   a timer in level 0, or the start of a higher slot that cascades */
+static tw_tick_t NextStop(tw_t *tw)
+{
+	tw_tick_t next = (tw_tick_t)-1;
+	tw_tick_t base = 0;
+	long distance = 0;
+	size_t level = 0;
+	
+	/* level 0 holds the exact ticks of the next TW_SLOTS ticks */
+	distance = NextBusySlot(tw, 0, tw->current);
+	if (-1 != distance)
+	{
+		next = tw->current + distance;
+	}
+	
+	/* higher levels only tell when their slot starts cascading */
+	for (level = 1; level < TW_LEVELS; ++level)
+	{
+		base = (tw->current >> LEVEL_SHIFT(level)) + 1;
+		
+		/* no slot of this level or above can start before next */
+		if ((base << LEVEL_SHIFT(level)) >= next)
+		{
+			break;
+		}
+		
+		distance = NextBusySlot(tw, level, base);
+		if (-1 != distance && ((base + distance) << LEVEL_SHIFT(level)) < next)
+		{
+			next = (base + distance) << LEVEL_SHIFT(level);
+		}
+	}
+	
+	return next;
+}
+
+/* This function returns the earliest expiry of the timers of a non empty slot */
+static tw_tick_t EarliestIn(tw_t *tw, dlist_t *slot)
+{
+	dlist_iter_t node = DListGetBegin(slot);
+	tw_tick_t earliest = tw->get_tick(DListGetData(node));
+	tw_tick_t expire = 0;
+	
+	for (node = DListNext(node); !DListIsEqual(node, DListGetEnd(slot)); node = DListNext(node))
+	{
+		expire = tw->get_tick(DListGetData(node));
+		if (expire < earliest)
+		{
+			earliest = expire;
+		}
+	}
+	
+	return earliest;
+}
+
+/* This function finds the exact tick of the earliest timer. a higher slot holds
+   the ticks of a whole range, so the first busy slot of each level is searched */
+static tw_tick_t FindNextExpiry(tw_t *tw)
+{
+	tw_tick_t next = (tw_tick_t)-1;
+	tw_tick_t base = 0;
+	tw_tick_t earliest = 0;
+	long distance = 0;
+	size_t level = 0;
+	
+	/* a level 0 slot holds a single tick, a due timer waits in the current one */
+	distance = NextBusySlot(tw, 0, tw->current);
+	if (-1 != distance)
+	{
+		next = tw->current + distance;
+	}
+	
+	for (level = 1; level < TW_LEVELS; ++level)
+	{
+		base = (tw->current >> LEVEL_SHIFT(level)) + 1;
+		
+		/* no timer of this level or above expires before next */
+		if ((base << LEVEL_SHIFT(level)) >= next)
+		{
+			break;
+		}
+		
+		distance = NextBusySlot(tw, level, base);
+		if (-1 != distance)
+		{
+			earliest = EarliestIn(tw, tw->slots[level][(base + distance) & SLOT_MASK]);
+			if (earliest < next)
+			{
+				next = earliest;
+			}
+		}
+	}
+	
+	return next;
+}
+
+/* This function moves a single node to the end of dest without reallocating it */
+static void MoveTo(dlist_iter_t node, dlist_t *dest)
+{
+	DListSplice(node, DListNext(node), DListGetEnd(dest));
+}
+
+/* This function spreads the timers of the current slot of level to lower levels */
+static void Cascade(tw_t *tw, size_t level)
+{
+	dlist_t *slot = tw->slots[level][SLOT_INDEX(tw->current, level)];
+	dlist_iter_t node = NULL;
+	
+	if (DListIsEmpty(slot))
+	{
+		return;
+	}
+	
+	/* pending is empty - the slot becomes pending as a whole, not node by node */
+	tw->slots[level][SLOT_INDEX(tw->current, level)] = tw->pending;
+	tw->pending = slot;
+	
+	while (!DListIsEmpty(tw->pending))
+	{
+		node = DListGetBegin(tw->pending);
+		MoveTo(node, SlotOf(tw, tw->get_tick(DListGetData(node))));
+	}
+}
+
+/* This function moves the wheel forward to the next busy tick, at most up to now */
+static void Advance(tw_t *tw, tw_tick_t now)
+{
+	size_t level = 1;
+	
+	/* every slot crossed on the way is empty, so only the landing tick cascades */
+	tw->current = NextStop(tw);
+	if (tw->current > now)
+	{
+		tw->current = now;
+	}
+	
+	while (level < TW_LEVELS && 0 == (tw->current & (LEVEL_SPAN(level) - 1)))
+	{
+		Cascade(tw, level);
+		++level;
+	}
+}
+
+/* This function frees the slot lists and the wheel itself */
+static void DestroySlots(tw_t *tw)
+{
+	size_t level = 0;
+	size_t slot = 0;
+	
+	for (level = 0; level < TW_LEVELS; ++level)
+	{
+		for (slot = 0; slot < TW_SLOTS; ++slot)
+		{
+			if (NULL != tw->slots[level][slot])
+			{
+				DListDestroy(tw->slots[level][slot]);
+			}
+		}
+	}
+	
+	DListDestroy(tw->pending);
+	SlabDestroy(tw->nodes);
+	free(tw);
+}
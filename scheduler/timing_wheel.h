@@ -0,0 +1,197 @@
+/************************************************ 
+EXERCISE      : DS#14: Hierarchical Timing Wheel
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : timing_wheel.h
+*************************************************/
+
+#ifndef __TIMING_WHEEL_H__
+#define __TIMING_WHEEL_H__
+
+#include <stddef.h> /* size_t */
+
+#include "dlist.h"
+
+#define TW_LEVEL_BITS (6)   /* a level's slots fit the bits of an unsigned long */
+#define TW_SLOTS      (1 << TW_LEVEL_BITS)
+#define TW_LEVELS     (6)   /* covers 2^36 ticks, later timers are re-cascaded */
+
+typedef struct timing_wheel tw_t;
+
+/* a stable handle to a timer, valid until the timer is removed or expires */
+typedef dlist_iter_t tw_handle_t;
+
+typedef unsigned long tw_tick_t;
+
+/*
+*    Get the tick in which data expires.
+*
+*    Arguments:
+*        data - the data stored in the wheel.
+*
+*    Return: the expiration tick of data.
+*
+*/
+typedef tw_tick_t (*tw_get_tick_t)(const void *data);
+
+/*
+*	creates a new empty timing wheel
+*
+*	Arguments:
+*		get_tick - returns the expiration tick of a data. can't be NULL.
+*		now - the current tick.
+*
+*	Return: a new timing wheel if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+tw_t *TWCreate(tw_get_tick_t get_tick, tw_tick_t now);
+
+/*
+*	frees all memory allocated for the timing wheel. the datas are not freed.
+*
+*	Arguments:
+*		tw - timing wheel to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void TWDestroy(tw_t *tw);
+
+/*
+*	add data to the wheel according to its expiration tick.
+*	datas that expired in the past expire on the next TWPopExpired.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		data - the data to add.
+*
+*	Return: handle to the new timer if successful, otherwise NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+tw_handle_t TWAdd(tw_t *tw, void *data);
+
+/*
+*	remove a timer from the wheel
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		handle - the handle returned by TWAdd. must be valid.
+*
+*	Return: the data of the removed timer.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *TWRemove(tw_t *tw, tw_handle_t handle);
+
+/*
+*	move a timer to the slot of its expiration tick after the tick of its
+*	data changed. the handle stays valid and nothing is allocated.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		handle - the handle returned by TWAdd. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void TWUpdate(tw_t *tw, tw_handle_t handle);
+
+/*
+*	remove the first timer whose data matches param
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		is_match - boolean match function. can't be NULL.
+*		param - the param to match.
+*
+*	Return: the removed data, or NULL if not found.
+*
+*	Time complexity: O(n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *TWRemoveIf(tw_t *tw, match_func_t is_match, const void *param);
+
+/*
+*	advance the wheel up to now and remove one expired timer.
+*	timers of the same tick expire in insertion order.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		now - the current tick, must not be before the previous now.
+*
+*	Return: data of an expired timer, or NULL if no timer expired by now.
+*
+*	Time complexity: O(1) amortized per elapsed tick
+*	Space complexity: O(1) best/average/worst
+*/
+void *TWPopExpired(tw_t *tw, tw_tick_t now);
+
+/*
+*	get the tick in which the earliest timer expires, the current tick for
+*	a timer already due. the result is kept until a timer is added, removed,
+*	updated or expires, so asking again costs nothing.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid and not empty.
+*
+*	Return: the next expiration tick.
+*
+*	Time complexity: O(1) if known, otherwise O(TW_LEVELS * TW_SLOTS) plus
+*					 the timers of the first busy slot of each higher level
+*	Space complexity: O(1) best/average/worst
+*/
+tw_tick_t TWNextExpiry(tw_t *tw);
+
+/*
+*	Do an action for each data in the wheel, in no particular order.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*		func - the action. can't be NULL. must not add or remove timers.
+*		param - the param of the action.
+*
+*	Return: 0 upon success, the return value of the failing func otherwise.
+*
+*	Time complexity: O(n) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+int TWForEach(tw_t *tw, action_func_t func, void *param);
+
+/*
+*	Remove all the timers from the wheel. the datas are not freed.
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void TWClear(tw_t *tw);
+
+/*
+*	Return the number of timers in the wheel
+*
+*	Arguments:
+*		tw - pointer to the timing wheel. must be valid.
+*
+*	Return: number of timers.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t TWSize(const tw_t *tw);
+
+#endif /* __TIMING_WHEEL_H__ */
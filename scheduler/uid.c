@@ -9,79 +9,153 @@ File          : uid.c
 #include "uid.h"
 
 #include <unistd.h>     /* getpid */
-#include <netinet/in.h> /* inet_ntoa */
-#include <arpa/inet.h>  /* inet_ntoa */
+#include <netinet/in.h> /* struct in_addr */
+#include <arpa/inet.h>  /* inet_ntop, inet_pton */
 #include <sys/socket.h> /* struct sockaddr_in */
 #include <ifaddrs.h>    /* getifaddrs */
 #include <time.h>       /* time */
-#include <string.h>     /* strcpy */
 #include <assert.h>     /* assert */
-#include <pthread.h>    /* mutex */
-#include <stdio.h>      /* fprintf */
-#include <stdlib.h>     /* EXIT_FAILURE */
+#include <pthread.h>    /* pthread_mutex_t, pthread_atfork */
+#include <stdatomic.h>  /* atomic_size_t */
 
 const ilrd_uid_t UIDBadUID = {0};
 
 enum status {SAME = 1 ,DIFFERENT = 0};
 
-#define MUTEX_SUCCESS   (0)   
+enum boolean_status {FALSE = 0 , TRUE = 1};
 
-/* This function gets a buffer and insert an IP address into it */
-static unsigned char *GetIPAddress(unsigned char *addr);
+/* odd, with the bits spread - 2^64 divided by the golden ratio */
+#define HASH_MULTIPLIER ((((uint64_t)0x9E3779B9UL) << 32) | 0x7F4A7C15UL)
+
+#define LOW_32_BITS (0xFFFFFFFFUL)
+#define PACK(high, low) ((((uint64_t)(high) & LOW_32_BITS) << 32) | ((uint64_t)(low) & LOW_32_BITS))
+#define HIGH_HALF(word) ((uint32_t)((word) >> 32))
+#define LOW_HALF(word)  ((uint32_t)((word) & LOW_32_BITS))
+
+/* pid_max of Linux is at most 2^22, the bits above the pid extend the counter */
+#define PID_BITS (22)
+#define PID_MASK ((1UL << PID_BITS) - 1)
+#define COUNTER_HIGH(count) ((uint32_t)((uint64_t)(count) >> 32) & ((1UL << (32 - PID_BITS)) - 1))
+
+/* 
+*  the address and the pid are looked up once, not for every UID. the 
+*  lookup is retried until it succeeds, and a forked child takes its own
+*  pid before it creates any UID.
+*/
+static pthread_mutex_t host_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int is_host_known;
+static uint32_t host_addr;   /* host byte order */
+static uint64_t host_word;   /* the hi word of every UID */
+
+/* shared by all threads, every UID takes the next value */
+static atomic_size_t counter;
+
+/* This function finds the first IPv4 address of the host */
+static int GetIPAddress(uint32_t *addr);
+
+/* This function looks up the host once, returns FALSE if it is unknown yet */
+static int KnowHost(void);
+
+/* This function is a fork handler that gives the child its own pid */
+static void TakeChildPid(void);
 
 ilrd_uid_t UIDCreate(void)
 {
-	static size_t counter = 0;
-
-    pthread_mutex_t mutex = {0};
-	
 	ilrd_uid_t new_uid = {0};
+	uint64_t count = 0;
 	
-    if (MUTEX_SUCCESS != pthread_mutex_init(&mutex, NULL))
-    {
-        fprintf(stderr, "Failed to create mutex.\n");
-        exit(EXIT_FAILURE);
-    }
-
-	if (NULL == GetIPAddress(new_uid.ip))
+	if (!KnowHost())
 	{
 		return UIDBadUID;
 	}
+	
+	count = atomic_fetch_add(&counter, 1);
+	new_uid.hi = host_word | ((uint64_t)COUNTER_HIGH(count) << PID_BITS);
+	new_uid.lo = PACK(time(NULL), count);
+	
+	return new_uid;
+}
 
-    pthread_mutex_lock(&mutex);
-    new_uid.counter = counter;
-    ++counter;
-    pthread_mutex_unlock(&mutex);
-    
-	new_uid.time = time(NULL);    
-    new_uid.pid = (size_t)getpid();
-    
-    if (MUTEX_SUCCESS != pthread_mutex_destroy(&mutex))
-    {
-        fprintf(stderr, "Failed to destroy mutex.\n");
-        exit(EXIT_FAILURE);
-    }
+int UIDIsSame(ilrd_uid_t uid1, ilrd_uid_t uid2)
+{
+	return (uid1.hi == uid2.hi && uid1.lo == uid2.lo) ? (SAME) : (DIFFERENT);
+}
 
-    return new_uid;
+size_t UIDHash(ilrd_uid_t uid)
+{
+	uint64_t hash = (uid.hi ^ uid.lo) * HASH_MULTIPLIER;
+	
+	/* the low bits pick the slot, fold the well mixed high bits into them */
+	return (size_t)(hash ^ (hash >> 32));
 }
 
-int UIDIsSame(ilrd_uid_t uid1, ilrd_uid_t uid2)
+ilrd_legacy_uid_t UIDToLegacy(ilrd_uid_t uid)
 {
-	if (uid1.counter != uid2.counter || uid1.time != uid2.time || uid1.pid != uid2.pid)
+	ilrd_legacy_uid_t legacy = {0};
+	struct in_addr addr = {0};
+	
+	if (UIDIsSame(uid, UIDBadUID))
+	{
+		return legacy;
+	}
+	
+	legacy.counter = (size_t)(((uint64_t)(LOW_HALF(uid.hi) >> PID_BITS) << 32) | LOW_HALF(uid.lo));
+	legacy.time = (time_t)HIGH_HALF(uid.lo);
+	legacy.pid = LOW_HALF(uid.hi) & PID_MASK;
+	
+	addr.s_addr = htonl(HIGH_HALF(uid.hi));
+	inet_ntop(AF_INET, &addr, (char *)legacy.ip, sizeof(legacy.ip));
+	
+	return legacy;
+}
+
+ilrd_uid_t UIDFromLegacy(const ilrd_legacy_uid_t *legacy)
+{
+	ilrd_uid_t uid = {0};
+	struct in_addr addr = {0};
+	
+	assert(NULL != legacy);
+	
+	if (1 != inet_pton(AF_INET, (const char *)legacy->ip, &addr))
+	{
+		return UIDBadUID;
+	}
+	
+	uid.hi = PACK(ntohl(addr.s_addr), (legacy->pid & PID_MASK) | (COUNTER_HIGH(legacy->counter) << PID_BITS));
+	uid.lo = PACK(legacy->time, legacy->counter);
+	
+	return uid;
+}
+
+/* This helper function looks up the host for every UID to come */
+static int KnowHost(void)
+{
+	if (TRUE == atomic_load_explicit(&is_host_known, memory_order_acquire))
 	{
-		return (DIFFERENT);
+		return TRUE;
 	}
 	
-	if (0 != strcmp( (char*)uid1.ip , (char*)uid2.ip))
+	pthread_mutex_lock(&host_lock);
+	if (FALSE == atomic_load_explicit(&is_host_known, memory_order_relaxed) &&
+	    TRUE == GetIPAddress(&host_addr))
 	{
-		return (DIFFERENT);
+		host_word = PACK(host_addr, getpid() & PID_MASK);
+		pthread_atfork(NULL, NULL, &TakeChildPid);
+		atomic_store_explicit(&is_host_known, TRUE, memory_order_release);
 	}
+	pthread_mutex_unlock(&host_lock);
 	
-	return (SAME);
+	return atomic_load_explicit(&is_host_known, memory_order_relaxed);
+}
+
+/* This helper function runs in a forked child, before anything else */
+static void TakeChildPid(void)
+{
+	host_word = PACK(host_addr, getpid() & PID_MASK);
 }
 
-/* This helper function loads an ip address into the UID */
-static unsigned char *GetIPAddress(unsigned char *addr)
+/* This helper function loads the ip address of the first IPv4 interface, 0 if none */
+static int GetIPAddress(uint32_t *addr)
 {
 	struct ifaddrs *ifap, *ifa;
     struct sockaddr_in *sa;
@@ -90,22 +164,21 @@ static unsigned char *GetIPAddress(unsigned char *addr)
     
     if (-1 == getifaddrs(&ifap))
     {
-    	return NULL;
+    	return FALSE;
     }
 
+    *addr = 0;
     for (ifa = ifap; ifa; ifa = ifa->ifa_next) 
     {
         if (ifa->ifa_addr && ifa->ifa_addr->sa_family==AF_INET) 
         {
             sa = (struct sockaddr_in *)ifa->ifa_addr;
-            strcpy( (char*)addr , inet_ntoa(sa->sin_addr) );
+            *addr = ntohl(sa->sin_addr.s_addr);
   			break;
         }
     }
 
     freeifaddrs(ifap);
 	
-    return addr;
+    return TRUE;
 }
-
-
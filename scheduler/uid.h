@@ -9,16 +9,34 @@ File          : uid.h
 #ifndef __UID_H__
 #define __UID_H__
 
-#include <time.h> /* time_t */
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <time.h>   /* time_t */
 
+/*
+*  128 bits in two words, so a UID is passed in two registers and is
+*  compared or hashed with two 64 bit operations.
+*    hi - IPv4 address of the host (32 bits), counter bits 32-41 (10 bits),
+*         pid (22 bits, the most Linux gives)
+*    lo - creation time in seconds (32 bits), counter bits 0-31 (32 bits)
+*  the counter is shared by the threads of the process and wraps after 
+*  2^42 UIDs, so two UIDs are the same only if that many are created 
+*  within one second.
+*/
 typedef struct uid
+{
+	uint64_t hi;
+	uint64_t lo;
+}ilrd_uid_t;
+
+/* the layout a UID had before, for code and records that still use it */
+typedef struct legacy_uid
 {
 	size_t counter;
 	time_t time;
 	size_t pid;
-	unsigned char ip[14];  
-	
-}ilrd_uid_t;
+	unsigned char ip[16];  /* dotted quad, room for 255.255.255.255 */
+}ilrd_legacy_uid_t;
 
 extern const ilrd_uid_t UIDBadUID;
 
@@ -52,5 +70,48 @@ ilrd_uid_t UIDCreate(void);
 */
 int UIDIsSame(ilrd_uid_t uid1, ilrd_uid_t uid2);
 
+/*
+*	Hashes a UID instance, for keeping UIDs in a hash table.
+*
+*	Arguments: An instance of UID struct.
+*
+*	Return: a hash value. UIDs that are the same have the same hash.
+*		
+*
+*	Time complexity: O(1)
+*	Space complexity: O(1)
+*
+*/
+size_t UIDHash(ilrd_uid_t uid);
+
+/*
+*	Converts a UID instance to the legacy layout.
+*
+*	Arguments: An instance of UID struct.
+*
+*	Return: the same UID in the legacy layout. a bad UID converts to all zero.
+*		
+*
+*	Time complexity: O(1)
+*	Space complexity: O(1)
+*
+*/
+ilrd_legacy_uid_t UIDToLegacy(ilrd_uid_t uid);
+
+/*
+*	Converts a UID in the legacy layout back to a UID instance.
+*
+*	Arguments: a UID in the legacy layout. must be a valid address.
+*	           time keeps its low 32 bits, counter its low 42 and pid its low 22.
+*
+*	Return: the UID, or a bad UID if the ip is not an IPv4 dotted quad.
+*		
+*
+*	Time complexity: O(1)
+*	Space complexity: O(1)
+*
+*/
+ilrd_uid_t UIDFromLegacy(const ilrd_legacy_uid_t *legacy);
+
 
 #endif /* __UID_H__ */
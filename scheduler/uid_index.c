@@ -0,0 +1,262 @@
+/************************************************ 
+EXERCISE      : DS#18: UID Hash Index
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : uid_index.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* calloc */
+#include <string.h>  /* memset */
+
+#include "uid_index.h"
+
+enum status {SUCCESS = 0 , FAILURE = 1};
+
+#define INITIAL_CAPACITY (64)   /* a power of 2 */
+#define FIRST_GENERATION (1)    /* a zero generation marks a free slot */
+
+typedef struct index_slot
+{
+	ilrd_uid_t uid;
+	void *data;
+	size_t generation;  /* in use only if equal to the generation of the index */
+} index_slot_t;
+
+/*
+*  linear probing, kept below half full so a probe ends after a few slots.
+*  a removal shifts the following slots back instead of leaving a marker.
+*  clearing starts a new generation, leaving the old slots free without
+*  touching them.
+*/
+struct uid_index
+{
+	index_slot_t *slots;
+	size_t capacity;
+	size_t size;
+	size_t generation;
+};
+
+/* Helper functions */
+static int IsUsed(const uid_index_t *index, const index_slot_t *slot);
+static size_t Home(const uid_index_t *index, ilrd_uid_t uid);
+static size_t FindSlot(const uid_index_t *index, ilrd_uid_t uid);
+static int Grow(uid_index_t *index, size_t capacity);
+
+/*-----------------UIDIndexCreate-----------------*/
+uid_index_t *UIDIndexCreate(void)
+{
+	uid_index_t *index = NULL;
+	
+	index = (uid_index_t *)malloc(sizeof(uid_index_t));
+	if (NULL == index)
+	{
+		return NULL;
+	}
+	
+	index->slots = (index_slot_t *)calloc(INITIAL_CAPACITY, sizeof(index_slot_t));
+	if (NULL == index->slots)
+	{
+		free(index);
+		return NULL;
+	}
+	
+	index->capacity = INITIAL_CAPACITY;
+	index->size = 0;
+	index->generation = FIRST_GENERATION;
+	
+	return index;
+}
+
+/*-----------------UIDIndexDestroy-----------------*/
+void UIDIndexDestroy(uid_index_t *index)
+{
+	assert(NULL != index);
+	
+	free(index->slots);
+	free(index);
+}
+
+/*-----------------UIDIndexInsert-----------------*/
+int UIDIndexInsert(uid_index_t *index, ilrd_uid_t uid, void *data)
+{
+	size_t i = 0;
+	
+	assert(NULL != index);
+	assert(NULL != data);
+	assert(NULL == UIDIndexFind(index, uid));
+	
+	if (SUCCESS != UIDIndexReserve(index, 1))
+	{
+		return FAILURE;
+	}
+	
+	for (i = Home(index, uid); IsUsed(index, &index->slots[i]); i = (i + 1) & (index->capacity - 1))
+	{
+	}
+	
+	index->slots[i].uid = uid;
+	index->slots[i].data = data;
+	index->slots[i].generation = index->generation;
+	++index->size;
+	
+	return SUCCESS;
+}
+
+/*-----------------UIDIndexReserve-----------------*/
+int UIDIndexReserve(uid_index_t *index, size_t count)
+{
+	size_t capacity = 0;
+	
+	assert(NULL != index);
+	
+	capacity = index->capacity;
+	while ((index->size + count) * 2 > capacity)
+	{
+		capacity *= 2;
+	}
+	
+	return (capacity == index->capacity) ? (SUCCESS) : (Grow(index, capacity));
+}
+
+/*-----------------UIDIndexFind-----------------*/
+void *UIDIndexFind(const uid_index_t *index, ilrd_uid_t uid)
+{
+	size_t i = 0;
+	
+	assert(NULL != index);
+	
+	i = FindSlot(index, uid);
+	
+	return (IsUsed(index, &index->slots[i])) ? (index->slots[i].data) : (NULL);
+}
+
+/*-----------------UIDIndexRemove-----------------*/
+void *UIDIndexRemove(uid_index_t *index, ilrd_uid_t uid)
+{
+	size_t mask = 0;
+	size_t hole = 0;
+	size_t next = 0;
+	size_t home = 0;
+	void *data = NULL;
+	
+	assert(NULL != index);
+	
+	mask = index->capacity - 1;
+	hole = FindSlot(index, uid);
+	if (!IsUsed(index, &index->slots[hole]))
+	{
+		return NULL;
+	}
+	
+	data = index->slots[hole].data;
+	
+	/* a slot may fill the hole if the hole is between its home and it */
+	for (next = (hole + 1) & mask; IsUsed(index, &index->slots[next]); next = (next + 1) & mask)
+	{
+		home = Home(index, index->slots[next].uid);
+		if (((next - home) & mask) >= ((next - hole) & mask))
+		{
+			index->slots[hole] = index->slots[next];
+			hole = next;
+		}
+	}
+	
+	index->slots[hole].data = NULL;
+	index->slots[hole].generation = 0;
+	--index->size;
+	
+	return data;
+}
+
+/*-----------------UIDIndexSize-----------------*/
+size_t UIDIndexSize(const uid_index_t *index)
+{
+	assert(NULL != index);
+	
+	return index->size;
+}
+
+/*-----------------UIDIndexClear-----------------*/
+void UIDIndexClear(uid_index_t *index)
+{
+	assert(NULL != index);
+	
+	index->size = 0;
+	++index->generation;
+	
+	/* after a wrap around old slots could look used again */
+	if (0 == index->generation)
+	{
+		memset(index->slots, 0, index->capacity * sizeof(index_slot_t));
+		index->generation = FIRST_GENERATION;
+	}
+}
+
+/* ------------Helper Functions------------ */
+
+/* This function checks if a slot holds a uid */
+static int IsUsed(const uid_index_t *index, const index_slot_t *slot)
+{
+	return (index->generation == slot->generation);
+}
+
+/* This function returns the slot a uid is looked for first */
+static size_t Home(const uid_index_t *index, ilrd_uid_t uid)
+{
+	return UIDHash(uid) & (index->capacity - 1);
+}
+
+/* This function returns the slot holding uid, or the free slot ending its probe */
+static size_t FindSlot(const uid_index_t *index, ilrd_uid_t uid)
+{
+	size_t i = Home(index, uid);
+	
+	while (IsUsed(index, &index->slots[i]) && !UIDIsSame(index->slots[i].uid, uid))
+	{
+		i = (i + 1) & (index->capacity - 1);
+	}
+	
+	return i;
+}
+
+/* This function enlarges the table to capacity and puts every uid in its new place */
+static int Grow(uid_index_t *index, size_t capacity)
+{
+	index_slot_t *old_slots = index->slots;
+	size_t old_capacity = index->capacity;
+	size_t old_generation = index->generation;
+	size_t i = 0;
+	size_t j = 0;
+	
+	index->slots = (index_slot_t *)calloc(capacity, sizeof(index_slot_t));
+	if (NULL == index->slots)
+	{
+		index->slots = old_slots;
+		return FAILURE;
+	}
+	
+	index->capacity = capacity;
+	index->generation = FIRST_GENERATION;
+	
+	for (i = 0; i < old_capacity; ++i)
+	{
+		if (old_generation != old_slots[i].generation)
+		{
+			continue;
+		}
+		
+		for (j = Home(index, old_slots[i].uid); IsUsed(index, &index->slots[j]); j = (j + 1) & (index->capacity - 1))
+		{
+		}
+		
+		index->slots[j] = old_slots[i];
+		index->slots[j].generation = FIRST_GENERATION;
+	}
+	
+	free(old_slots);
+	
+	return SUCCESS;
+}
@@ -0,0 +1,133 @@
+/************************************************ 
+EXERCISE      : DS#18: UID Hash Index
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : uid_index.h
+*************************************************/
+
+#ifndef __UID_INDEX_H__
+#define __UID_INDEX_H__
+
+#include <stddef.h> /* size_t */
+#include "uid.h"
+
+/*
+*  maps a uid to a data with open addressing, so finding, adding and
+*  removing take O(1) on average whatever the number of uids. the table
+*  only grows. not thread safe - one thread at a time.
+*/
+typedef struct uid_index uid_index_t;
+
+/*
+*	creates a new empty index
+*
+*	Arguments: none.
+*
+*	Return: a new index if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+uid_index_t *UIDIndexCreate(void);
+
+/*
+*	frees all memory allocated for the index. the datas are not touched.
+*
+*	Arguments:
+*		index - index to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void UIDIndexDestroy(uid_index_t *index);
+
+/*
+*	maps uid to data
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*		uid - the key. must not be in the index.
+*		data - the value. can't be NULL.
+*
+*	Return: 0 - success,
+*			1 - memory allocation failure, the index is unchanged.
+*
+*	Time complexity: O(1) average, O(n) worst
+*	Space complexity: O(1) amortized, O(n) when the table grows
+*/
+int UIDIndexInsert(uid_index_t *index, ilrd_uid_t uid, void *data);
+
+/*
+*	makes room for count more uids, so inserting them does not grow the table
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*		count - number of uids about to be inserted.
+*
+*	Return: 0 - success,
+*			1 - memory allocation failure, the index is unchanged.
+*
+*	Time complexity: O(1) if there is room, O(n + count) otherwise
+*	Space complexity: O(n + count) when the table grows, O(1) otherwise
+*/
+int UIDIndexReserve(uid_index_t *index, size_t count);
+
+/*
+*	finds the data mapped to uid
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*		uid - the key to look for.
+*
+*	Return: the data, or NULL if uid is not in the index.
+*
+*	Time complexity: O(1) average, O(n) worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *UIDIndexFind(const uid_index_t *index, ilrd_uid_t uid);
+
+/*
+*	removes uid from the index
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*		uid - the key to remove.
+*
+*	Return: the data it was mapped to, or NULL if uid is not in the index.
+*
+*	Time complexity: O(1) average, O(n) worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *UIDIndexRemove(uid_index_t *index, ilrd_uid_t uid);
+
+/*
+*	number of uids in the index
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*
+*	Return: the number of uids.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t UIDIndexSize(const uid_index_t *index);
+
+/*
+*	removes every uid, keeping the table for reuse
+*
+*	Arguments:
+*		index - pointer to the index. must be valid.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average, O(capacity) worst
+*	Space complexity: O(1) best/average/worst
+*/
+void UIDIndexClear(uid_index_t *index);
+
+#endif /* __UID_INDEX_H__ */
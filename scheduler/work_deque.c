@@ -0,0 +1,181 @@
+/************************************************ 
+EXERCISE      : DS#16: Work Stealing Deque
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : work_deque.c
+*************************************************/
+
+#include <stddef.h>  /* size_t */
+#include <assert.h>  /* assert */
+#include <stdlib.h>  /* malloc */
+#include <pthread.h> /* pthread_mutex_t */
+
+#include "work_deque.h"
+
+enum status {SUCCESS = 0 , FAILURE = 1};
+
+#define INITIAL_CAPACITY (16)
+#define GROWTH_FACTOR    (2)
+
+/* a ring buffer, front is the oldest job */
+struct work_deque
+{
+	void **jobs;
+	size_t front;
+	size_t size;
+	size_t capacity;
+	pthread_mutex_t lock;
+};
+
+/* Helper functions */
+static int Grow(work_deque_t *deque);
+
+/*-----------------WorkDequeCreate-----------------*/
+work_deque_t *WorkDequeCreate(void)
+{
+	work_deque_t *deque = (work_deque_t *)malloc(sizeof(work_deque_t));
+	if (NULL == deque)
+	{
+		return NULL;
+	}
+	
+	deque->jobs = (void **)malloc(INITIAL_CAPACITY * sizeof(void *));
+	if (NULL == deque->jobs)
+	{
+		free(deque);
+		return NULL;
+	}
+	
+	if (0 != pthread_mutex_init(&deque->lock, NULL))
+	{
+		free(deque->jobs);
+		free(deque);
+		return NULL;
+	}
+	
+	deque->front = 0;
+	deque->size = 0;
+	deque->capacity = INITIAL_CAPACITY;
+	
+	return deque;
+}
+
+/*-----------------WorkDequeDestroy-----------------*/
+void WorkDequeDestroy(work_deque_t *deque)
+{
+	assert(NULL != deque);
+	
+	pthread_mutex_destroy(&deque->lock);
+	free(deque->jobs);
+	deque->jobs = NULL;
+	free(deque);
+}
+
+/*-----------------WorkDequePush-----------------*/
+int WorkDequePush(work_deque_t *deque, void *job)
+{
+	int status = SUCCESS;
+	
+	assert(NULL != deque);
+	
+	pthread_mutex_lock(&deque->lock);
+	
+	if (deque->size == deque->capacity)
+	{
+		status = Grow(deque);
+	}
+	
+	if (SUCCESS == status)
+	{
+		deque->jobs[(deque->front + deque->size) % deque->capacity] = job;
+		++deque->size;
+	}
+	
+	pthread_mutex_unlock(&deque->lock);
+	
+	return status;
+}
+
+/*-----------------WorkDequePop-----------------*/
+void *WorkDequePop(work_deque_t *deque)
+{
+	void *job = NULL;
+	
+	assert(NULL != deque);
+	
+	pthread_mutex_lock(&deque->lock);
+	
+	if (0 != deque->size)
+	{
+		job = deque->jobs[deque->front];
+		deque->front = (deque->front + 1) % deque->capacity;
+		--deque->size;
+	}
+	
+	pthread_mutex_unlock(&deque->lock);
+	
+	return job;
+}
+
+/*-----------------WorkDequeSteal-----------------*/
+void *WorkDequeSteal(work_deque_t *deque)
+{
+	void *job = NULL;
+	
+	assert(NULL != deque);
+	
+	pthread_mutex_lock(&deque->lock);
+	
+	if (0 != deque->size)
+	{
+		--deque->size;
+		job = deque->jobs[(deque->front + deque->size) % deque->capacity];
+	}
+	
+	pthread_mutex_unlock(&deque->lock);
+	
+	return job;
+}
+
+/*-----------------WorkDequeSize-----------------*/
+size_t WorkDequeSize(work_deque_t *deque)
+{
+	size_t size = 0;
+	
+	assert(NULL != deque);
+	
+	pthread_mutex_lock(&deque->lock);
+	size = deque->size;
+	pthread_mutex_unlock(&deque->lock);
+	
+	return size;
+}
+
+/*--------------- Helper Functions--------------------*/
+
+/* This function doubles the ring, unwrapping it to start at index 0 */
+static int Grow(work_deque_t *deque)
+{
+	size_t new_capacity = deque->capacity * GROWTH_FACTOR;
+	void **new_jobs = NULL;
+	size_t i = 0;
+	
+	new_jobs = (void **)malloc(new_capacity * sizeof(void *));
+	if (NULL == new_jobs)
+	{
+		return FAILURE;
+	}
+	
+	for (i = 0; i < deque->size; ++i)
+	{
+		new_jobs[i] = deque->jobs[(deque->front + i) % deque->capacity];
+	}
+	
+	free(deque->jobs);
+	deque->jobs = new_jobs;
+	deque->front = 0;
+	deque->capacity = new_capacity;
+	
+	return SUCCESS;
+}
@@ -0,0 +1,101 @@
+/************************************************ 
+EXERCISE      : DS#16: Work Stealing Deque
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : work_deque.h
+*************************************************/
+
+#ifndef __WORK_DEQUE_H__
+#define __WORK_DEQUE_H__
+
+#include <stddef.h> /* size_t */
+
+/* 
+*  a deque of jobs owned by one worker thread. jobs are pushed to the back,
+*  the owner takes the oldest from the front and idle workers steal the
+*  newest from the back. every operation is safe from any thread.
+*/
+typedef struct work_deque work_deque_t;
+
+/*
+*	creates a new empty deque
+*
+*	Arguments: None.
+*
+*	Return: a new deque if successful
+*				otherwise return NULL.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+work_deque_t *WorkDequeCreate(void);
+
+/*
+*	frees all memory allocated for the deque. the jobs are not freed.
+*
+*	Arguments:
+*		deque - deque to destroy. must be a valid address.
+*
+*	Return: void.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void WorkDequeDestroy(work_deque_t *deque);
+
+/*
+*	add a job to the back of the deque.
+*
+*	Arguments:
+*		deque - pointer to the deque. must be valid.
+*		job - the job to add.
+*
+*	Return: 0 - success,
+*			1 - failure.
+*
+*	Time complexity: O(1) amortized
+*	Space complexity: O(1) amortized
+*/
+int WorkDequePush(work_deque_t *deque, void *job);
+
+/*
+*	remove the oldest job. used by the owner of the deque.
+*
+*	Arguments:
+*		deque - pointer to the deque. must be valid.
+*
+*	Return: the removed job, or NULL if the deque is empty.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *WorkDequePop(work_deque_t *deque);
+
+/*
+*	remove the newest job. used by the other workers.
+*
+*	Arguments:
+*		deque - pointer to the deque. must be valid.
+*
+*	Return: the removed job, or NULL if the deque is empty.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+void *WorkDequeSteal(work_deque_t *deque);
+
+/*
+*	number of jobs in the deque. may be stale by the time it returns.
+*
+*	Arguments:
+*		deque - pointer to the deque. must be valid.
+*
+*	Return: number of jobs.
+*
+*	Time complexity: O(1) best/average/worst
+*	Space complexity: O(1) best/average/worst
+*/
+size_t WorkDequeSize(work_deque_t *deque);
+
+#endif /* __WORK_DEQUE_H__ */
@@ -0,0 +1,159 @@
+/************************************************ 
+EXERCISE      : Scheduler stats query test
+Implmented by : Snir Holland
+Reviewed by   : 
+Date          : 18/10/2026
+File          : sched_query_test.c
+*************************************************/
+
+#define _POSIX_C_SOURCE 200112L /* alarm */
+#include <stdio.h>     /* printf */
+#include <stdatomic.h> /* atomic_int */
+#include <pthread.h>   /* pthread_create, pthread_join */
+#include <unistd.h>    /* alarm */
+
+#include "scheduler.h"
+
+#ifndef ROUNDS
+#define ROUNDS         (300)
+#endif
+#define READERS        (4)
+#define INTERVAL_NS    (100000)
+#define TIMEOUT_SEC    (60)
+
+/*
+*  queries the stats of a task from another thread while SchedRun ends,
+*  stopped by that thread or out of tasks. every query must return - a
+*  query left waiting for a SchedRun that returned hangs the test, and
+*  the alarm ends it as a failure.
+*
+*  usage: sched_query_test.out
+*/
+
+typedef struct query_round
+{
+	sched_t *sched;
+	ilrd_uid_t uid;
+	int runs_left;
+	int to_stop;          /* the reader stops SchedRun, or the task ends it */
+	atomic_int is_started; /* the task ran - SchedRun is active */
+	atomic_int is_done;
+	atomic_ulong answered;
+	atomic_ulong not_found;
+	atomic_ulong failed;
+} query_round_t;
+
+static int CountDown(void *round);
+static void NoClean(void *param);
+static void *Reader(void *round);
+
+int main(void)
+{
+	query_round_t round = {0};
+	sched_task_desc_t desc = {0};
+	pthread_t readers[READERS] = {0};
+	size_t failed = 0;
+	size_t answered = 0;
+	size_t i = 0;
+	size_t j = 0;
+	
+	/* SIGALRM ends the process if a query hangs */
+	alarm(TIMEOUT_SEC);
+	
+	for (i = 0; i < ROUNDS; ++i)
+	{
+		round.sched = SchedCreate((0 == i % 2) ? SCHED_QUEUE : SCHED_WHEEL);
+		if (NULL == round.sched)
+		{
+			printf("FAIL: SchedCreate\n");
+			return 1;
+		}
+		
+		desc.interval_ns = INTERVAL_NS;
+		desc.oper_func = &CountDown;
+		desc.oper_params = &round;
+		desc.clean_func = &NoClean;
+		round.uid = SchedAddTask(round.sched, &desc);
+		round.runs_left = 1 + (int)(i % 50);
+		round.to_stop = (0 == i % 3);
+		atomic_store(&round.answered, 0);
+		atomic_store(&round.not_found, 0);
+		atomic_store(&round.failed, 0);
+		atomic_store(&round.is_started, 0);
+		atomic_store(&round.is_done, 0);
+		
+		for (j = 0; j < READERS; ++j)
+		{
+			pthread_create(&readers[j], NULL, &Reader, &round);
+		}
+		SchedRun(round.sched);
+		atomic_store(&round.is_done, 1);
+		for (j = 0; j < READERS; ++j)
+		{
+			pthread_join(readers[j], NULL);
+		}
+		
+		SchedDestroy(round.sched);
+		
+		failed += atomic_load(&round.failed);
+		answered += atomic_load(&round.answered);
+	}
+	
+	printf("%lu queries answered, %lu failed\n", (unsigned long)answered, (unsigned long)failed);
+	printf("%s\n", (0 == failed) ? "PASS" : "FAIL");
+	
+	return (0 != failed);
+}
+
+/* This function runs runs_left times, then leaves SchedRun out of tasks */
+static int CountDown(void *round)
+{
+	query_round_t *self = (query_round_t *)round;
+	
+	atomic_store(&self->is_started, 1);
+	--self->runs_left;
+	
+	return (0 < self->runs_left || self->to_stop) ? OP_CONTINUE : OP_DONE;
+}
+
+static void NoClean(void *param)
+{
+	(void)param;
+}
+
+/* This function queries the stats until SchedRun returned, stopping it after some answers */
+static void *Reader(void *round)
+{
+	query_round_t *self = (query_round_t *)round;
+	sched_task_stats_t stats = {0};
+	int status = 0;
+	
+	/* other threads may only call while SchedRun is active */
+	while (!atomic_load(&self->is_started) && !atomic_load(&self->is_done))
+	{
+	}
+	
+	while (!atomic_load(&self->is_done))
+	{
+		status = SchedGetTaskStats(self->sched, self->uid, &stats);
+		if (SUCCESS == status)
+		{
+			atomic_fetch_add(&self->answered, 1);
+		}
+		else if (NOT_FOUND == status)
+		{
+			atomic_fetch_add(&self->not_found, 1);
+		}
+		else
+		{
+			atomic_fetch_add(&self->failed, 1);
+		}
+		
+		if (self->to_stop && 10 <= atomic_load(&self->answered))
+		{
+			SchedStop(self->sched);
+		}
+	}
+	
+	return NULL;
+}
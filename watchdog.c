@@ -9,32 +9,56 @@ File          : watchdog.c
 #define _XOPEN_SOURCE   /* sigset_t */
 #define _POSIX_SOURCE   /* sigaction */
 #define _DEFAULT_SOURCE /* cancel unsetenv warning */
+#define _GNU_SOURCE     /* memfd_create */
 #include <stdlib.h>     /* fprintf */
 #include <stdio.h>      /* printf */
 #include <signal.h>
+#include <errno.h>      /* errno */
+#include <stdint.h>     /* uint64_t */
 #include <stdatomic.h> /* atomic_int */
 #include <semaphore.h> /* sem_t, semaphore functions */
-#include <fcntl.h>     /* O_CREAT*/
 #include <unistd.h>    /* getpid, getppid*/
 #include <pthread.h>   /* pthread_create, pthread_join */
-
+#include <sys/mman.h>  /* memfd_create, mmap */
+#include <sys/eventfd.h> /* eventfd */
+#include <sys/wait.h>  /* waitpid */
+#include <sys/syscall.h> /* SYS_pidfd_open */
+#include <poll.h>      /* poll */
+#include <string.h>    /* strlen, strcpy */
+#include <limits.h>    /* PATH_MAX */
+
+#include "watchdog.h"
 #include "scheduler.h"
+#include "mono_time.h"
 
-#define TASK1_DELAY (0)
-#define TASK1_INTERVAL (1)
-#define TASK2_DELAY (0)
-#define TASK2_INTERVAL (5)
-#define TASK3_DELAY (0)
-#define TASK3_INTERVAL (1)
+/* Task1 beats every beat_interval_ms. Task2 catches a hung peer - it checks
+   every max_misses beats, first after grace_ms. an exited peer is caught at
+   once by the peer watch */
+#define TASK1_DELAY_MS (0)
+#define TASK3_DELAY_MS (0)
+#define TASK3_INTERVAL_MS (1000)
+#define TASK4_DELAY_MS (0)
 
-#define SEM_PERMISSIONS (0644)
-#define SEM_NAME ("/wd_sem")
-#define SEM_MODE (O_CREAT)
+#define SEM_SHARED (1)
 #define SEM_INITIAL_VALUE (0)
 
+#define SHM_NAME ("wd_heartbeat")
+#define SHM_FD_ENV ("WD_SHM_FD")
+
 #define PID_BUFFSIZE (10)
+#define FD_BUFFSIZE (12)
+#define DEATH_LOG_SIZE (16) /* the last deaths kept, however many revives */
 #define CHILD (0)
-#define WATCHDOG_PATH ("./wd_exec.out")
+
+/* what WDStart uses */
+#define DEFAULT_BEAT_INTERVAL_MS (1000)
+#define DEFAULT_MAX_MISSES (5)
+#define DEFAULT_GRACE_MS (5000) /* give the peer a full check period to beat */
+#define DEFAULT_WATCHDOG_PATH ("./wd_exec.out")
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open (434) /* Linux 5.3, the same number on every architecture */
+#endif
 
 enum wd_status
 {
@@ -48,27 +72,80 @@ enum dnr_status
     TRUE
 };
 
+enum wd_role
+{
+    WD_CLIENT,
+    WD_WATCHDOG,
+    WD_ROLES
+};
+
+/* written only by its own process, read by the peer */
+typedef struct wd_heartbeat
+{
+    atomic_ulong beats;        /* counts on across revivals */
+    atomic_ulong last_beat_ns; /* MonoTimeNow of the last beat */
+} wd_heartbeat_t;
+
+/* the wd_config_t of the first client, for every peer after it */
+typedef struct wd_settings
+{
+    size_t beat_interval_ms;
+    size_t max_misses;
+    size_t grace_ms;
+    char watchdog_path[PATH_MAX];
+} wd_settings_t;
+
+/* shared by the client and the watchdog, inherited across fork and exec */
+typedef struct wd_shared
+{
+    wd_settings_t settings;    /* written once, before the watchdog starts */
+    wd_heartbeat_t hearts[WD_ROLES];
+    sem_t ready;               /* posted by a started or revived peer */
+} wd_shared_t;
+
+/* how a monitored process ended */
+typedef struct wd_death
+{
+    pid_t pid;
+    int exit_status;  /* -1 if it did not exit, or is not our child */
+    int term_signal;  /* 0 if no signal ended it */
+    uint64_t time_ns; /* MonoTimeNow when it was replaced */
+} wd_death_t;
+
 /* -------------- Global variables ----------------- */
 sched_t *sched = NULL;
 sem_t *semaphore = NULL;
-atomic_int life_count = 0;
+wd_shared_t *shared = NULL;
+int shared_fd = -1;
+int role = WD_CLIENT;
+unsigned long last_seen_beats = 0;
 int dnr_wd = FALSE;
-pid_t monitored_pid = 0;
+atomic_int monitored_pid = 0; /* written by the scheduler thread, read by the peer watch */
 pthread_t scheduler_thread = 0;
+ilrd_uid_t check_uid = {0};
+pthread_t watch_thread = 0;
+int watch_fd = -1;          /* eventfd - written on a revive and on a stop */
+atomic_int watch_stop = FALSE;
+atomic_int exited_pid = 0;  /* set by the peer watch, taken by the check */
+wd_death_t deaths[DEATH_LOG_SIZE] = {{0}};
+size_t death_count = 0;     /* all of them - deaths[death_count % DEATH_LOG_SIZE] is next */
 
 /* -------------- Tasks ----------------- */
 static int TaskIncrementLifeCount(void *param);
 static int TaskCheckLifeCount(void *param);
 static int TaskCheckDnrStatus(void *param);
+static int TaskOpenPeerWatch(void *param);
 
 /* -------------- Signal Handlers ----------------- */
-static void HandlerSIGUSR1(int sig, siginfo_t *sig_info, void *ucontext);
 static void HandlerSIGUSR2(int sig, siginfo_t *sig_info, void *ucontext);
 
 /* -------------- Static functions ----------------- */
 static int InitSched(char **file_path);
+static ilrd_uid_t AddTask(size_t delay_ms, size_t interval_ms, int (*task)(void *), void *param);
 static void InitHandlers();
 static void InitSemaphore();
+static int InitShared(const wd_config_t *config);
+static void CloseShared();
 static void *RunSched(void *param);
 static void DummyClean(void *param);
 static void SetWDEnvVar();
@@ -76,29 +153,67 @@ static pid_t GetPidFromEnv();
 static int IsRunningProcessWatchdog();
 static int IsWatchdogActive();
 static int Revive(char **file_path);
+static void RetirePeer(int exited);
+static void StartPeerWatch();
+static void StopPeerWatch();
+static void NotifyPeerWatch();
+static void *WatchPeer(void *param);
+static void PollRetry(struct pollfd *fds, nfds_t count);
 
 /* -------------- API ----------------- */
 int WDStart(char **file_path)
+{
+    wd_config_t config = {0};
+
+    config.file_path = file_path;
+    config.watchdog_path = DEFAULT_WATCHDOG_PATH;
+    config.beat_interval_ms = DEFAULT_BEAT_INTERVAL_MS;
+    config.max_misses = DEFAULT_MAX_MISSES;
+    config.grace_ms = DEFAULT_GRACE_MS;
+
+    return WDStartEx(&config);
+}
+
+int WDStartEx(const wd_config_t *config)
 {
     sigset_t set = {0};
+    char **file_path = NULL;
+
+    if (NULL == config || NULL == config->file_path || NULL == config->watchdog_path ||
+        0 == config->beat_interval_ms || 0 == config->max_misses ||
+        config->grace_ms < config->beat_interval_ms ||
+        PATH_MAX <= strlen(config->watchdog_path))
+    {
+        fprintf(stderr, "Invalid watchdog configuration.\n");
+        return WD_FAILURE;
+    }
+
+    file_path = config->file_path;
 
     printf("---- Process #%d Started -----\n", getpid());
     printf("Initializing...\n");
 
     InitHandlers();
+    if (WD_SUCCESS != InitShared(config))
+    {
+        fprintf(stderr, "Shared heartbeats failed.\n");
+        return WD_FAILURE;
+    }
+
+    role = IsRunningProcessWatchdog() ? WD_WATCHDOG : WD_CLIENT;
     InitSched(file_path);
     InitSemaphore();
 
     if (!IsWatchdogActive())
     {
-        monitored_pid = fork();
+        atomic_store(&monitored_pid, fork());
 
         if (CHILD == monitored_pid)
         {
             printf("Executing watchdog...\n");
 
             SetWDEnvVar();
-            execl(WATCHDOG_PATH, *file_path);
+            execl(shared->settings.watchdog_path, *file_path, (char *)NULL);
         }
 
         printf("waiting for watchdog initialization to finish...\n");
@@ -107,12 +222,13 @@ int WDStart(char **file_path)
 
         printf("watchdog initialization finished!! starting thread...\n");
 
+        StartPeerWatch();
         pthread_create(&scheduler_thread, NULL, &RunSched, NULL);
     }
 
     else if (IsRunningProcessWatchdog())
     {
-        monitored_pid = getppid();
+        atomic_store(&monitored_pid, getppid());
 
         printf("I am watchdog with pid: %d.\n", getpid());
         printf("My parent (user) has pid: %d.\n", getppid());
@@ -120,17 +236,31 @@ int WDStart(char **file_path)
 
         sem_post(semaphore);
 
+        StartPeerWatch();
         RunSched(sched);
+
+        /* stopped by the DNR task - the scheduler is not running any more */
+        SchedDestroy(sched);
+        sched = NULL;
+
+        unsetenv("WD_PID");
+
+        sem_destroy(semaphore);
     }
 
     else
     {
-        monitored_pid = GetPidFromEnv();
+        /* revived by the watchdog - beat like a started client */
+        atomic_store(&monitored_pid, GetPidFromEnv());
+
+        sem_post(semaphore);
+
+        StartPeerWatch();
+        pthread_create(&scheduler_thread, NULL, &RunSched, NULL);
     }
 
     sigemptyset(&set);
 
-    sigaddset(&set, SIGUSR1);
     sigaddset(&set, SIGUSR2);
 
     sigprocmask(SIG_BLOCK, &set, NULL);
@@ -149,9 +279,25 @@ void WDStop(size_t timeout)
         timeout = sleep(timeout);
     }
 
+    /* the watchdog is about to exit, it must not be revived */
+    StopPeerWatch();
+
     /* Send SIGUSR2*/
     kill(monitored_pid, SIGUSR2);
 
+    /* the scheduler thread wakes up at once, no need to wait for its next task */
+    if (0 != scheduler_thread)
+    {
+        SchedStop(sched);
+        pthread_join(scheduler_thread, NULL);
+        scheduler_thread = 0;
+
+        SchedDestroy(sched);
+        sched = NULL;
+    }
+
+    CloseShared();
+
     sigfillset(&set);
     sigprocmask(SIG_UNBLOCK, &set, NULL);
 }
@@ -159,32 +305,46 @@ void WDStop(size_t timeout)
 /* -------------- InitSched ----------------- */
 static int InitSched(char **file_path)
 {
+    wd_settings_t *settings = &shared->settings;
+
     printf("Initializing schedule...\n");
 
-    sched = SchedCreate();
+    sched = SchedCreate(SCHED_QUEUE);
     if (NULL == sched)
     {
         fprintf(stderr, "Memory allocation failed.\n");
         return WD_FAILURE;
     }
 
-    SchedAdd(sched, TASK1_DELAY, TASK1_INTERVAL, &TaskIncrementLifeCount, NULL, NULL, &DummyClean);
-    SchedAdd(sched, TASK2_DELAY, TASK2_INTERVAL, &TaskCheckLifeCount, (void *)file_path, NULL, &DummyClean);
+    AddTask(TASK1_DELAY_MS, settings->beat_interval_ms, &TaskIncrementLifeCount, NULL);
+    check_uid = AddTask(settings->grace_ms, settings->beat_interval_ms * settings->max_misses,
+                        &TaskCheckLifeCount, (void *)file_path);
     if (IsRunningProcessWatchdog())
     {
         printf("Adding third task to wd scheduler...\n");
-        SchedAdd(sched, TASK3_DELAY, TASK3_INTERVAL, &TaskCheckDnrStatus, NULL, NULL, &DummyClean);
+        AddTask(TASK3_DELAY_MS, TASK3_INTERVAL_MS, &TaskCheckDnrStatus, NULL);
     }
+    /* runs once, no interval */
+    AddTask(TASK4_DELAY_MS, 0, &TaskOpenPeerWatch, NULL);
 
     return SUCCESS;
 }
 
-static void HandlerSIGUSR1(int sig, siginfo_t *sig_info, void *ucontext)
+/* -------------- AddTask ----------------- */
+static ilrd_uid_t AddTask(size_t delay_ms, size_t interval_ms, int (*task)(void *), void *param)
 {
-    printf("SIGUSR1 Recieved!\n");
-    printf("Incrementing life count of other process %d.\n", monitored_pid);
-    atomic_fetch_add(&life_count, 1);
-    printf("life counter = %d\n", life_count);
+    sched_task_desc_t desc = {0};
+
+    desc.delay_ns = (uint64_t)delay_ms * 1000000UL;
+    desc.interval_ns = (uint64_t)interval_ms * 1000000UL;
+    /* after a stall, beat once instead of catching up */
+    desc.overrun = SCHED_SKIP_MISSED;
+    desc.oper_func = task;
+    desc.oper_params = param;
+    desc.clean_params = NULL;
+    desc.clean_func = &DummyClean;
+
+    return SchedAddTask(sched, &desc);
 }
 
 static void HandlerSIGUSR2(int sig, siginfo_t *sig_info, void *ucontext)
@@ -196,10 +356,11 @@ static void HandlerSIGUSR2(int sig, siginfo_t *sig_info, void *ucontext)
 
 static int TaskIncrementLifeCount(void *param)
 {
-    /* Task1: send SIGUSR1 */
-    printf("Sending SIGUSR1 to other process.\n");
+    /* Task1: beat in the shared segment - no signal, no syscall */
+    wd_heartbeat_t *heart = &shared->hearts[role];
 
-    kill(monitored_pid, SIGUSR1);
+    atomic_store_explicit(&heart->last_beat_ns, MonoTimeNow(), memory_order_relaxed);
+    atomic_fetch_add_explicit(&heart->beats, 1, memory_order_release);
 
     return OP_CONTINUE;
 }
@@ -208,19 +369,33 @@ static int TaskCheckLifeCount(void *param)
 {
     /* Task2: check friend's counter */
     char **file_path = (char **)param;
+    wd_heartbeat_t *peer = &shared->hearts[WD_ROLES - 1 - role];
+    unsigned long beats = atomic_load_explicit(&peer->beats, memory_order_acquire);
+    pid_t exited = atomic_exchange(&exited_pid, 0);
 
     printf("Checking counter of other process.\n");
 
-    if (0 != life_count)
+    if (0 != exited && monitored_pid != exited)
     {
-        printf("Life signal recieved, resetting count.\n");
-        atomic_fetch_xor(&life_count, life_count);
-        printf("life counter = %d\n", life_count);
+        /* a peer already replaced - its exit only ran the check early */
+        return OP_CONTINUE;
+    }
+
+    /* an exited peer may have beaten since the last check */
+    if (0 == exited && beats != last_seen_beats)
+    {
+        printf("Life signal recieved %lu ms ago.\n",
+               (unsigned long)((MonoTimeNow() - atomic_load(&peer->last_beat_ns)) / NS_IN_MS));
+        last_seen_beats = beats;
     }
     else
     {
         printf("Reviving...\n");
+        RetirePeer(0 != exited);
         Revive(file_path);
+
+        /* the revived peer gets the same grace as a started one */
+        SchedReschedule(sched, check_uid, (uint64_t)shared->settings.grace_ms * 1000000UL);
     }
 
     return OP_CONTINUE;
@@ -234,15 +409,10 @@ static int TaskCheckDnrStatus(void *param)
 
     if (dnr_wd)
     {
-        pthread_join(scheduler_thread, NULL);
+        StopPeerWatch();
 
-        SchedClear(sched);
+        /* the scheduler is running this task - WDStartEx destroys it once SchedRun returns */
         SchedStop(sched);
-        SchedDestroy(sched);
-
-        unsetenv("WD_PID");
-
-        sem_destroy(semaphore);
 
         return OP_DONE;
     }
@@ -250,6 +420,16 @@ static int TaskCheckDnrStatus(void *param)
     return OP_CONTINUE;
 }
 
+static int TaskOpenPeerWatch(void *param)
+{
+    /* Task4: SchedRun is active now, the peer watch may queue its reschedules */
+    (void)param;
+
+    NotifyPeerWatch();
+
+    return OP_DONE;
+}
+
 static void DummyClean(void *param)
 {
     (void)param;
@@ -257,18 +437,13 @@ static void DummyClean(void *param)
 
 static void InitHandlers()
 {
-    struct sigaction sigusr1_action = {0};
     struct sigaction sigusr2_action = {0};
 
     printf("Initializing handlers.\n");
 
-    sigusr1_action.sa_flags = SA_SIGINFO;
     sigusr2_action.sa_flags = SA_SIGINFO;
-
-    sigusr1_action.sa_sigaction = &HandlerSIGUSR1;
     sigusr2_action.sa_sigaction = &HandlerSIGUSR2;
 
-    sigaction(SIGUSR1, &sigusr1_action, NULL);
     sigaction(SIGUSR2, &sigusr2_action, NULL);
 }
 
@@ -276,11 +451,78 @@ static void InitSemaphore()
 {
     printf("Initializing semaphore.\n");
 
-    semaphore = sem_open(SEM_NAME, SEM_MODE, SEM_PERMISSIONS, SEM_INITIAL_VALUE);
+    /* in the shared segment, the same one for the peer after its exec */
+    semaphore = &shared->ready;
+}
+
+static int InitShared(const wd_config_t *config)
+{
+    char fd_env[FD_BUFFSIZE] = {0};
+    char *fd_str = getenv(SHM_FD_ENV);
+    int fd = -1;
+
+    printf("Initializing shared heartbeats.\n");
+
+    if (NULL != fd_str)
+    {
+        /* a revived or watchdog process - the peer left the segment open */
+        fd = atoi(fd_str);
+    }
+    else
+    {
+        /* no MFD_CLOEXEC, the segment passes to the peer with the fd */
+        fd = memfd_create(SHM_NAME, 0);
+        if (-1 == fd)
+        {
+            return WD_FAILURE;
+        }
+
+        if (-1 == ftruncate(fd, sizeof(wd_shared_t)))
+        {
+            close(fd);
+            return WD_FAILURE;
+        }
+
+    }
+
+    shared = (wd_shared_t *)mmap(NULL, sizeof(wd_shared_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == shared)
+    {
+        shared = NULL;
+        close(fd);
+        return WD_FAILURE;
+    }
+
+    if (NULL == fd_str)
+    {
+        /* the handshake - every peer after this one takes these values */
+        shared->settings.beat_interval_ms = config->beat_interval_ms;
+        shared->settings.max_misses = config->max_misses;
+        shared->settings.grace_ms = config->grace_ms;
+        strcpy(shared->settings.watchdog_path, config->watchdog_path);
 
-    /* unlink prevents the semaphore existing forever
-       if a crash occurs during the execution         */
-    sem_unlink(SEM_NAME);
+        sem_init(&shared->ready, SEM_SHARED, SEM_INITIAL_VALUE);
+
+        sprintf(fd_env, "%d", fd);
+        setenv(SHM_FD_ENV, fd_env, 1);
+    }
+
+    shared_fd = fd;
+
+    return WD_SUCCESS;
+}
+
+static void CloseShared()
+{
+    if (NULL != shared)
+    {
+        munmap(shared, sizeof(wd_shared_t));
+        shared = NULL;
+    }
+
+    close(shared_fd);
+    shared_fd = -1;
+    unsetenv(SHM_FD_ENV);
 }
 
 static void SetWDEnvVar()
@@ -326,22 +568,195 @@ static int Revive(char **file_path)
     revived_pid = fork();
     if (CHILD == revived_pid)
     {
-        if (IsRunningProcessWatchdog())
+        /* role, not the pid - the child's pid is never the watchdog's */
+        if (WD_WATCHDOG == role)
         {
-            execl(*file_path, *file_path);
+            execl(*file_path, *file_path, (char *)NULL);
         }
         else
         {
             SetWDEnvVar();
-            execl(WATCHDOG_PATH, *file_path);
+            execl(shared->settings.watchdog_path, *file_path, (char *)NULL);
         }
     }
     else
     {
-        monitored_pid = revived_pid;
+        atomic_store(&monitored_pid, revived_pid);
     }
 
     sem_wait(semaphore);
 
+    NotifyPeerWatch();
+
     return WD_SUCCESS;
 }
+
+static void RetirePeer(int exited)
+{
+    /* the peer is about to be replaced - reap it, or it stays a zombie */
+    wd_death_t *death = &deaths[death_count % DEATH_LOG_SIZE];
+    pid_t reaped = 0;
+    int status = 0;
+
+    ++death_count;
+    death->pid = monitored_pid;
+    death->exit_status = -1;
+    death->term_signal = 0;
+    death->time_ns = MonoTimeNow();
+
+    if (!exited && getppid() != monitored_pid)
+    {
+        /* hung - it would run on next to its replacement. the watchdog's
+           first client is its parent, not killed */
+        kill(monitored_pid, SIGKILL);
+    }
+
+    /* fails at once with ECHILD if it is not our child - its parent reaps it */
+    do
+    {
+        reaped = waitpid(monitored_pid, &status, 0);
+    } while (-1 == reaped && EINTR == errno);
+
+    if (monitored_pid != reaped)
+    {
+        printf("Process #%d ended, not our child to reap.\n", monitored_pid);
+        return;
+    }
+
+    if (WIFEXITED(status))
+    {
+        death->exit_status = WEXITSTATUS(status);
+    }
+    else if (WIFSIGNALED(status))
+    {
+        death->term_signal = WTERMSIG(status);
+    }
+
+    printf("Process #%d reaped, exit status %d, signal %d. %lu deaths so far.\n",
+           monitored_pid, death->exit_status, death->term_signal, (unsigned long)death_count);
+}
+
+/* -------------- Peer watch ----------------- */
+static void StartPeerWatch()
+{
+    printf("Watching process #%d for exit.\n", monitored_pid);
+
+    watch_fd = eventfd(0, EFD_CLOEXEC);
+    if (-1 == watch_fd)
+    {
+        /* the heartbeat check still catches the exit, a period later */
+        return;
+    }
+
+    if (0 != pthread_create(&watch_thread, NULL, &WatchPeer, NULL))
+    {
+        close(watch_fd);
+        watch_fd = -1;
+        watch_thread = 0;
+    }
+}
+
+static void StopPeerWatch()
+{
+    if (0 == watch_thread)
+    {
+        return;
+    }
+
+    atomic_store(&watch_stop, TRUE);
+    NotifyPeerWatch();
+
+    pthread_join(watch_thread, NULL);
+    watch_thread = 0;
+
+    close(watch_fd);
+    watch_fd = -1;
+}
+
+static void NotifyPeerWatch()
+{
+    uint64_t one = 1;
+
+    if (-1 != watch_fd && sizeof(one) != write(watch_fd, &one, sizeof(one)))
+    {
+        fprintf(stderr, "Peer watch notify failed.\n");
+    }
+}
+
+static void *WatchPeer(void *param)
+{
+    /* a pidfd turns readable when its process exits, child or not -
+       the watchdog watches its parent, so SIGCHLD would not do */
+    struct pollfd fds[2] = {{0}};
+    uint64_t count = 0;
+    int pid_fd = -1;
+    pid_t pid = 0;
+
+    (void)param;
+
+    fds[0].events = POLLIN;
+    fds[0].fd = -1;
+    fds[1].fd = watch_fd;
+    fds[1].events = POLLIN;
+
+    /* before SchedRun is active SchedReschedule would change the scheduler
+       under it - wait for TaskOpenPeerWatch, or a stop */
+    PollRetry(fds, 2);
+    if (sizeof(count) != read(watch_fd, &count, sizeof(count)))
+    {
+        return NULL;
+    }
+
+    while (!atomic_load(&watch_stop))
+    {
+        pid = atomic_load(&monitored_pid);
+        pid_fd = (int)syscall(SYS_pidfd_open, pid, 0);
+        if (-1 == pid_fd && ESRCH != errno)
+        {
+            /* no pidfd in this kernel - the heartbeat check is left */
+            break;
+        }
+
+        fds[0].fd = pid_fd;
+        fds[0].revents = 0;
+        if (-1 != pid_fd)
+        {
+            PollRetry(fds, 2);
+        }
+
+        if (-1 == pid_fd || 0 != fds[0].revents)
+        {
+            if (!dnr_wd)
+            {
+                printf("Process #%d exited, checking at once.\n", pid);
+
+                atomic_store(&exited_pid, pid);
+                SchedReschedule(sched, check_uid, 0);
+            }
+
+            /* until Revive has a new pid to watch, or a stop */
+            fds[0].fd = -1;
+            PollRetry(fds, 2);
+        }
+
+        if (-1 != pid_fd)
+        {
+            close(pid_fd);
+        }
+
+        if (0 != fds[1].revents && sizeof(count) != read(watch_fd, &count, sizeof(count)))
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static void PollRetry(struct pollfd *fds, nfds_t count)
+{
+    /* SIGUSR2 may land on this thread */
+    while (-1 == poll(fds, count, -1) && EINTR == errno)
+    {
+    }
+}
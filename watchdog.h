@@ -11,6 +11,28 @@ File          : watchdog.c
 
 #include <stddef.h> /*size_t*/
 
+/**
+ * wd_config_t
+ * Description: 
+ *      Tuning of a watchdog, for WDStartEx. a process revived later, or
+ *      the watchdog itself, takes the values of the client that started first.
+ * Fields:
+ *      file_path: path of executable file, like argv
+ *      watchdog_path: path of the watchdog executable
+ *      beat_interval_ms: time between two heartbeats. must be positive
+ *      max_misses: heartbeats missed in a row before a revive. must be positive
+ *      grace_ms: time after a start or a revive before the first check. at
+ *          least beat_interval_ms, or a healthy peer is revived before it beats
+*/
+typedef struct wd_config
+{
+    char **file_path;
+    const char *watchdog_path;
+    size_t beat_interval_ms;
+    size_t max_misses;
+    size_t grace_ms;
+} wd_config_t;
+
 /**
  * WDStart
  * Description: 
@@ -22,6 +44,19 @@ File          : watchdog.c
 */
 int WDStart(char **file_path);
 
+/**
+ * WDStartEx
+ * Description: 
+ *      Same as WDStart, with the timing and the watchdog path of config.
+ *      WDStart beats every second, revives after 5 missed beats and
+ *      waits 5 seconds before the first check, with ./wd_exec.out.
+ * Arguments:
+ *      config: tuning of the watchdog
+ * Return: 
+ *      status of watchdog operation, a failure for an invalid config     
+*/
+int WDStartEx(const wd_config_t *config);
+
 /**
  * WDStop
  * Description: 